@@ -0,0 +1,117 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <span>
+#include <string>
+#include "AST/AST.h"
+#include "LexerParser/Parser.h"
+
+using namespace TinyCobalt;
+
+namespace {
+    struct Input {
+        std::string text;
+        // Statements at any depth, blocks included.
+        std::size_t statements = 0;
+    };
+
+    // Expression statements nested kDepth parentheses deep.
+    Input deepExpressions(std::size_t size) {
+        constexpr int kDepth = 256;
+        Input input;
+        input.text.reserve(size + 4 * kDepth);
+        while (input.text.size() < size) {
+            input.text += "a = ";
+            for (int i = 0; i < kDepth; ++i)
+                input.text += "(b + ";
+            input.text += "1";
+            input.text.append(kDepth, ')');
+            input.text += ";\n";
+            ++input.statements;
+        }
+        return input;
+    }
+
+    // One function whose body is a single long list of statements.
+    Input longStatementList(std::size_t size) {
+        Input input;
+        input.text.reserve(size + 64);
+        input.text += "int main() {\n";
+        input.statements = 2;
+        while (input.text.size() < size) {
+            input.text += "    x = x * 3 + y[2] - f(z, 0x1f);\n";
+            input.text += "    if (x > 10) return x;\n";
+            input.statements += 3;
+        }
+        input.text += "}\n";
+        return input;
+    }
+
+    // Many struct definitions.
+    Input manyStructs(std::size_t size) {
+        Input input;
+        input.text.reserve(size + 128);
+        for (std::size_t i = 0; input.text.size() < size; ++i) {
+            auto index = std::to_string(i);
+            input.text += "struct S" + index + " { int a; float b; Pointer<S" + index + "> next; };\n";
+            ++input.statements;
+        }
+        return input;
+    }
+
+    template<typename Parser>
+    void lexTokens(benchmark::State &state, Input (*generate)(std::size_t)) {
+        auto input = generate(static_cast<std::size_t>(state.range(0)));
+        std::size_t tokens = 0;
+        for (auto _: state) {
+            Parser parser;
+            parser.switchInput(std::span<const char>(input.text));
+            tokens = parser.lex();
+            benchmark::DoNotOptimize(tokens);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.text.size()));
+        state.counters["tokens/s"] =
+                benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+    template<typename Parser>
+    void parseStatements(benchmark::State &state, Input (*generate)(std::size_t)) {
+        auto input = generate(static_cast<std::size_t>(state.range(0)));
+        for (auto _: state) {
+            Parser parser;
+            parser.switchInput(std::span<const char>(input.text));
+            if (parser.parse() != 0) {
+                state.SkipWithError("parse failed");
+                return;
+            }
+            auto root = parser.result();
+            benchmark::DoNotOptimize(root);
+            // Freeing the tree is part of the cost of a parse.
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.text.size()));
+        state.counters["statements/s"] = benchmark::Counter(static_cast<double>(input.statements),
+                                                            benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+    // 1 KB to 100 MB.
+    void inputSizes(benchmark::internal::Benchmark *bench) {
+        for (int64_t size: {int64_t{1} << 10, int64_t{1} << 16, int64_t{1} << 20, int64_t{16} << 20, int64_t{100} << 20})
+            bench->Arg(size);
+        bench->Unit(benchmark::kMillisecond);
+    }
+} // namespace
+
+#define TINY_COBALT_BENCH_INPUT(Generator)                                                                             \
+    BENCHMARK_CAPTURE(lexTokens<LexerParser::Parser>, Generator##_flex, Generator)->Apply(inputSizes);                \
+    BENCHMARK_CAPTURE(lexTokens<LexerParser::DirectParser>, Generator##_direct, Generator)->Apply(inputSizes);        \
+    BENCHMARK_CAPTURE(parseStatements<LexerParser::Parser>, Generator##_flex, Generator)->Apply(inputSizes);          \
+    BENCHMARK_CAPTURE(parseStatements<LexerParser::DirectParser>, Generator##_direct, Generator)->Apply(inputSizes);
+
+TINY_COBALT_BENCH_INPUT(deepExpressions)
+TINY_COBALT_BENCH_INPUT(longStatementList)
+TINY_COBALT_BENCH_INPUT(manyStructs)
+
+BENCHMARK_MAIN();
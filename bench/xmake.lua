@@ -0,0 +1,9 @@
+add_requires("benchmark")
+
+target("tiny-cobalt-bench")
+    set_kind("binary")
+    set_default(false)
+    add_deps("tiny-cobalt-library")
+    add_cxxflags("clang::-fsized-deallocation")
+    add_files("**.cpp")
+    add_packages("benchmark")
@@ -6,6 +6,8 @@
 #define TINY_COBALT_INCLUDE_AST_BASEASTNODE_H_
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <proxy.h>
@@ -13,6 +15,7 @@
 #include <variant>
 #include "Common/Generator.h"
 #include "Common/JSON.h"
+#include "Common/Location.h"
 #include "Common/Utility.h"
 
 
@@ -24,12 +27,27 @@
 
 namespace TinyCobalt::AST {
 
+    // Defined in AST/NodeKind.h with one enumerator per entry of TINY_COBALT_AST_NODES.
+    enum class NodeKind : std::uint8_t;
+    // The kind of a node struct, specialized for each of them in AST/NodeKind.h.
+    template<typename T>
+    struct NodeKindOf;
+
     PRO_DEF_MEM_DISPATCH(MemTraverse, traverse);
+    PRO_DEF_MEM_DISPATCH(MemChildCount, childCount);
+    PRO_DEF_MEM_DISPATCH(MemChild, child);
     PRO_DEF_MEM_DISPATCH(MemThisPointer, thisPointer);
+    PRO_DEF_MEM_DISPATCH(MemKind, kind);
 
     struct ASTNodeProxy // NOLINT
         : pro::facade_builder // NOLINT
           ::add_convention<MemTraverse, Utility::Generator<pro::proxy<ASTNodeProxy>>()> // NOLINT
+          // Children by index, in the order of traverse(). A missing child, e.g. an absent else branch, is an empty
+          // proxy. Unlike traverse(), these do not allocate a coroutine frame.
+          ::add_convention<MemChildCount, std::size_t() const> // NOLINT
+          ::add_convention<MemChild, pro::proxy<ASTNodeProxy>(std::size_t) const> // NOLINT
+          // Used by visit() to jump straight to the candidates of a node instead of trying each of them.
+          ::add_convention<MemKind, NodeKind() const> // NOLINT
           // FIXME: erased type information may lead to memory leaks
           ::add_convention<MemThisPointer, void *() const> // NOLINT
           // TODO: rewrite toJSON() using generator.
@@ -40,9 +58,25 @@ namespace TinyCobalt::AST {
           ::build {};
 
 
+    using ASTNodePtr = pro::proxy<ASTNodeProxy>;
+    using ASTNodeGen = Utility::Generator<ASTNodePtr>;
+
+    // Generator over child(0), ..., child(childCount() - 1) of a node.
+    template<typename T>
+    ASTNodeGen traverseChildren(const T &node) {
+        for (std::size_t i = 0, size = node.childCount(); i < size; ++i)
+            co_yield node.child(i);
+    }
+
     template<typename T>
     struct EnableThisPointer : public std::enable_shared_from_this<T> {
+        static constexpr NodeKind kKind = NodeKindOf<T>::value;
+        NodeKind kind() const { return kKind; }
         void *thisPointer() const { return const_cast<void *>(reinterpret_cast<const void *>(this)); }
+        // Kept for callers that iterate with range-for. The visitor uses childCount() and child() instead.
+        ASTNodeGen traverse() const { return traverseChildren(static_cast<const T &>(*this)); }
+        // Source range of the node. Decode it with the SourceManager of the compilation.
+        Common::Location location;
     };
 
     template<typename T>
@@ -64,9 +98,6 @@ namespace TinyCobalt::AST {
     template<typename T>
     concept VariantASTNodePtrConcept = detail::VariantASTNodePtrImpl<T>::value;
 
-    using ASTNodePtr = pro::proxy<ASTNodeProxy>;
-    using ASTNodeGen = Utility::Generator<ASTNodePtr>;
-
 
     inline std::ostream &operator<<(std::ostream &os, const ASTNodePtr &node) { return os << node->toJSON(); }
 
@@ -5,28 +5,43 @@
 #ifndef TINY_COBALT_INCLUDE_AST_ASTNODEDECL_H_
 #define TINY_COBALT_INCLUDE_AST_ASTNODEDECL_H_
 
+#include <array>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <magic_enum.hpp>
+#include <string>
+#include <string_view>
 #include <variant>
 #include "AST/ASTNode.h"
 #include "AST/ExprNode.h"
+#include "AST/NodeKind.h"
 #include "AST/StmtNode.h"
 #include "AST/TypeNode.h"
 #include "Common/Assert.h"
+#include "Common/PerfectHash.h"
+#include "Common/Symbol.h"
 #include "Common/Utility.h"
 
 namespace TinyCobalt::AST {
 
     // TypeNode
 
-    // TODO: implement convertibleTo.
+    // TODO: implicit conversions. A type is only convertible to itself, which for canonical nodes of a
+    // Semantic::TypeContext is a pointer comparison.
+    template<typename T>
+    bool isSameNode(const T &node, const pro::proxy<TypeNodeProxy> &other) {
+        return other && other->thisPointer() == node.thisPointer();
+    }
+
     struct SimpleTypeNode : public EnableThisPointer<SimpleTypeNode> {
-        const std::string name;
+        const Common::Symbol name;
         using TypeDefPtr = std::variant<AST::AliasDefPtr, AST::StructDefPtr, AST::SimpleTypePtr, std::nullptr_t>;
         TypeDefPtr def = nullptr;
-        explicit SimpleTypeNode(std::string name) : name(std::move(name)) {}
-        ASTNodeGen traverse();
-        bool convertibleTo(const pro::proxy<TypeNodeProxy> &other) const { return false; }
+        explicit SimpleTypeNode(Common::Symbol name) : name(name) {}
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        bool convertibleTo(const pro::proxy<TypeNodeProxy> &other) const { return isSameNode(*this, other); }
         Common::JSON toJSON() const;
     };
 
@@ -36,8 +51,9 @@ namespace TinyCobalt::AST {
         FuncTypeNode(TypeNodePtr returnType, std::vector<TypeNodePtr> paramTypes) :
             returnType(std::move(returnType)), paramTypes(std::move(paramTypes)) {}
         FuncTypeNode(TypeNodePtr returnType) : returnType(std::move(returnType)), paramTypes() {}
-        ASTNodeGen traverse();
-        bool convertibleTo(const pro::proxy<TypeNodeProxy> &other) const { return false; }
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        bool convertibleTo(const pro::proxy<TypeNodeProxy> &other) const { return isSameNode(*this, other); }
         Common::JSON toJSON() const;
     };
     /**
@@ -49,13 +65,14 @@ namespace TinyCobalt::AST {
     struct ComplexTypeNode : public EnableThisPointer<ComplexTypeNode> {
         using TemplateArgType = std::variant<TypeNodePtr, ConstExprPtr>;
         struct Visitor;
-        const std::string templateName;
+        const Common::Symbol templateName;
         const std::vector<TemplateArgType> templateArgs;
-        explicit ComplexTypeNode(std::string templateName, std::vector<TemplateArgType> templateArgs) :
-            templateName(std::move(templateName)), templateArgs(std::move(templateArgs)) {}
+        explicit ComplexTypeNode(Common::Symbol templateName, std::vector<TemplateArgType> templateArgs) :
+            templateName(templateName), templateArgs(std::move(templateArgs)) {}
 
-        ASTNodeGen traverse();
-        bool convertibleTo(const pro::proxy<TypeNodeProxy> &other) const { return false; }
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        bool convertibleTo(const pro::proxy<TypeNodeProxy> &other) const { return isSameNode(*this, other); }
         Common::JSON toJSON() const;
     };
 
@@ -66,55 +83,66 @@ namespace TinyCobalt::AST {
         const SimpleTypeNode Bool("bool");
         const SimpleTypeNode Char("char");
         const SimpleTypeNode Void("void");
-        inline constexpr SimpleTypePtr findType(const std::string &name) {
-            static auto kIntPtr = std::make_shared<SimpleTypeNode>(Int);
-            static auto kUIntPtr = std::make_shared<SimpleTypeNode>(UInt);
-            static auto kFloatPtr = std::make_shared<SimpleTypeNode>(Float);
-            static auto kBoolPtr = std::make_shared<SimpleTypeNode>(Bool);
-            static auto kCharPtr = std::make_shared<SimpleTypeNode>(Char);
-            static auto kVoidPtr = std::make_shared<SimpleTypeNode>(Void);
-            if (name == "int") {
-                return kIntPtr;
-            } else if (name == "uint") {
-                return kUIntPtr;
-            } else if (name == "float") {
-                return kFloatPtr;
-            } else if (name == "bool") {
-                return kBoolPtr;
-            } else if (name == "char") {
-                return kCharPtr;
-            } else if (name == "void") {
-                return kVoidPtr;
-            }
+        // Names of the builtin types. The lexer shares this table to recognize them as type names.
+        inline constexpr std::array<std::string_view, 6> kNames = {"int", "uint", "float", "bool", "char", "void"};
+        inline constexpr Common::PerfectHash kNameHash(kNames);
+        inline SimpleTypePtr findType(std::string_view name) {
+            // Same order as kNames.
+            static const std::array<SimpleTypePtr, kNames.size()> kTypes = {
+                    std::make_shared<SimpleTypeNode>(Int),  std::make_shared<SimpleTypeNode>(UInt),
+                    std::make_shared<SimpleTypeNode>(Float), std::make_shared<SimpleTypeNode>(Bool),
+                    std::make_shared<SimpleTypeNode>(Char), std::make_shared<SimpleTypeNode>(Void),
+            };
+            if (auto index = kNameHash.find(name))
+                return kTypes[*index];
             return nullptr;
         }
     } // namespace BuiltInType
 
     // ExprNode
+    // Every expression node stores the type resolved for it by TypeAnalyzer in its own slot, so that results of
+    // different nodes are kept apart and can be computed concurrently.
     // TODO: Compile-time evaluation
-    // FIXME: Implement exprType()
     struct ConstExprNode : public EnableThisPointer<ConstExprNode> {
-        const std::string value;
+        // The decoded literal. Integers of every base are stored as uint64_t; strings keep their quoted spelling.
+        using Value = std::variant<std::uint64_t, double, bool, char, Common::Symbol>;
+        const Value value;
         const ConstExprType type;
-        explicit ConstExprNode(std::string value, ConstExprType type) : value(value), type(type) {}
-        ASTNodeGen traverse();
-        TypeNodePtr &exprType() {
-            static TypeNodePtr ptr_ = nullptr;
-            return ptr_;
-        }
+        explicit ConstExprNode(ConstExprType type, Value value) : value(std::move(value)), type(type) {}
+        // Decode the spelling of a literal. A template so that a string is not taken for a Symbol value.
+        template<typename Text>
+            requires std::convertible_to<Text, std::string_view>
+        explicit ConstExprNode(ConstExprType type, Text &&text) :
+            value(decode(std::string_view(text), type)), type(type) {}
+        /**
+         * Decode the spelling of a literal of the given type, e.g. "0x1f" for HexInt or "'a'" for Char.
+         * @throw std::invalid_argument if text is not a literal of the type.
+         * @throw std::out_of_range if the value does not fit.
+         */
+        static Value decode(std::string_view text, ConstExprType type);
+        // The canonical spelling of the value. It equals the source text except for the letter case and leading zeros
+        // of integers and the formatting of floats.
+        std::string text() const;
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        TypeNodePtr &exprType() { return exprType_; }
         Common::JSON toJSON() const;
+
+    private:
+        TypeNodePtr exprType_ = nullptr;
     };
 
     struct VariableNode : public EnableThisPointer<VariableNode> {
-        const std::string name;
+        const Common::Symbol name;
         VariableDefPtr def = nullptr;
-        explicit VariableNode(std::string name) : name(std::move(name)) {}
-        ASTNodeGen traverse();
-        TypeNodePtr &exprType() {
-            static TypeNodePtr ptr_ = nullptr;
-            return ptr_;
-        }
+        explicit VariableNode(Common::Symbol name) : name(name) {}
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        TypeNodePtr &exprType() { return exprType_; }
         Common::JSON toJSON() const;
+
+    private:
+        TypeNodePtr exprType_ = nullptr;
     };
 
     // TODO: support infix for binary function like Haskell
@@ -124,24 +152,26 @@ namespace TinyCobalt::AST {
         ExprNodePtr rhs;
         explicit BinaryNode(ExprNodePtr lhs, BinaryOp op, ExprNodePtr rhs) :
             op(std::move(op)), lhs(std::move(lhs)), rhs(std::move(rhs)) {}
-        ASTNodeGen traverse();
-        TypeNodePtr &exprType() {
-            static TypeNodePtr ptr_ = nullptr;
-            return ptr_;
-        }
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        TypeNodePtr &exprType() { return exprType_; }
         Common::JSON toJSON() const;
+
+    private:
+        TypeNodePtr exprType_ = nullptr;
     };
 
     struct UnaryNode : public EnableThisPointer<UnaryNode> {
         const UnaryOp op;
         ExprNodePtr operand;
         explicit UnaryNode(UnaryOp op, ExprNodePtr operand) : op(std::move(op)), operand(std::move(operand)) {}
-        ASTNodeGen traverse();
-        TypeNodePtr &exprType() {
-            static TypeNodePtr ptr_ = nullptr;
-            return ptr_;
-        }
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        TypeNodePtr &exprType() { return exprType_; }
         Common::JSON toJSON() const;
+
+    private:
+        TypeNodePtr exprType_ = nullptr;
     };
 
     // Operators with multiple params, for example, operator[].
@@ -152,12 +182,13 @@ namespace TinyCobalt::AST {
         std::vector<ExprNodePtr> operands;
         explicit MultiaryNode(MultiaryOp op, ExprNodePtr obj, std::vector<ExprNodePtr> operands = {}) :
             op(op), object(obj), operands(std::move(operands)) {}
-        ASTNodeGen traverse();
-        TypeNodePtr &exprType() {
-            static TypeNodePtr ptr_ = nullptr;
-            return ptr_;
-        }
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        TypeNodePtr &exprType() { return exprType_; }
         Common::JSON toJSON() const;
+
+    private:
+        TypeNodePtr exprType_ = nullptr;
     };
 
     struct CastNode : public EnableThisPointer<CastNode> {
@@ -166,12 +197,13 @@ namespace TinyCobalt::AST {
         ExprNodePtr operand;
         explicit CastNode(CastType op, TypeNodePtr type, ExprNodePtr operand) :
             op(op), type(std::move(type)), operand(std::move(operand)) {}
-        ASTNodeGen traverse();
-        TypeNodePtr &exprType() {
-            static TypeNodePtr ptr_ = nullptr;
-            return ptr_;
-        }
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        TypeNodePtr &exprType() { return exprType_; }
         Common::JSON toJSON() const;
+
+    private:
+        TypeNodePtr exprType_ = nullptr;
     };
 
     // Three way conditional operator
@@ -181,26 +213,28 @@ namespace TinyCobalt::AST {
         ExprNodePtr falseBranch;
         explicit ConditionNode(ExprNodePtr condition, ExprNodePtr trueBranch, ExprNodePtr falseBranch) :
             condition(std::move(condition)), trueBranch(std::move(trueBranch)), falseBranch(std::move(falseBranch)) {}
-        ASTNodeGen traverse();
-        TypeNodePtr &exprType() {
-            static TypeNodePtr ptr_ = nullptr;
-            return ptr_;
-        }
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        TypeNodePtr &exprType() { return exprType_; }
         Common::JSON toJSON() const;
+
+    private:
+        TypeNodePtr exprType_ = nullptr;
     };
 
     struct MemberNode : public EnableThisPointer<MemberNode> {
         ExprNodePtr object;
         BinaryOp op;
-        std::string member;
-        explicit MemberNode(ExprNodePtr object, BinaryOp op, std::string member) :
-            object(std::move(object)), op(op), member(std::move(member)) {}
-        ASTNodeGen traverse();
-        TypeNodePtr &exprType() {
-            static TypeNodePtr ptr_ = nullptr;
-            return ptr_;
-        }
+        Common::Symbol member;
+        explicit MemberNode(ExprNodePtr object, BinaryOp op, Common::Symbol member) :
+            object(std::move(object)), op(op), member(member) {}
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        TypeNodePtr &exprType() { return exprType_; }
         Common::JSON toJSON() const;
+
+    private:
+        TypeNodePtr exprType_ = nullptr;
     };
 
     namespace BuiltInOperator {
@@ -216,7 +250,8 @@ namespace TinyCobalt::AST {
         const StmtNodePtr elseStmt;
         IfNode(ExprNodePtr condition, StmtNodePtr thenStmt, StmtNodePtr elseStmt) :
             condition(std::move(condition)), thenStmt(std::move(thenStmt)), elseStmt(std::move(elseStmt)) {}
-        ASTNodeGen traverse();
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
@@ -225,7 +260,8 @@ namespace TinyCobalt::AST {
         const ExprNodePtr condition;
         const StmtNodePtr body;
         WhileNode(ExprNodePtr condition, StmtNodePtr body) : condition(std::move(condition)), body(std::move(body)) {}
-        ASTNodeGen traverse();
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
@@ -237,7 +273,8 @@ namespace TinyCobalt::AST {
         const StmtNodePtr body;
         ForNode(ExprNodePtr init, ExprNodePtr condition, ExprNodePtr step, StmtNodePtr body) :
             init(std::move(init)), condition(std::move(condition)), step(std::move(step)), body(std::move(body)) {}
-        ASTNodeGen traverse();
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
@@ -245,7 +282,8 @@ namespace TinyCobalt::AST {
     struct ReturnNode : public EnableThisPointer<ReturnNode> {
         const ExprNodePtr value;
         explicit ReturnNode(ExprNodePtr value) : value(std::move(value)) {}
-        ASTNodeGen traverse();
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
@@ -253,30 +291,34 @@ namespace TinyCobalt::AST {
     struct BlockNode : public EnableThisPointer<BlockNode> {
         std::vector<StmtNodePtr> stmts;
         explicit BlockNode(std::vector<StmtNodePtr> stmts) : stmts(std::move(stmts)) {}
-        ASTNodeGen traverse();
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
 
     struct BreakNode : public EnableThisPointer<BreakNode> {
-        ASTNodeGen traverse();
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
 
     struct ContinueNode : public EnableThisPointer<ContinueNode> {
-        ASTNodeGen traverse();
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
 
     struct VariableDefNode : public EnableThisPointer<VariableDefNode> {
         const TypeNodePtr type;
-        const std::string name;
+        const Common::Symbol name;
         const ExprNodePtr init;
-        VariableDefNode(TypeNodePtr type, std::string name, ExprNodePtr init = nullptr) :
-            type(type), name(std::move(name)), init(init) {}
-        ASTNodeGen traverse();
+        VariableDefNode(TypeNodePtr type, Common::Symbol name, ExprNodePtr init = nullptr) :
+            type(type), name(name), init(init) {}
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
@@ -289,15 +331,15 @@ namespace TinyCobalt::AST {
         };
         using ParamsElem = std::shared_ptr<ParamsElemNode>;
         const TypeNodePtr returnType;
-        const std::string name;
+        const Common::Symbol name;
         const std::vector<ParamsElem> params;
         const StmtNodePtr body;
-        FuncDefNode(TypeNodePtr returnType, std::string name, std::vector<ParamsElem> params, StmtNodePtr body) :
-            returnType(std::move(returnType)), name(std::move(name)), params(std::move(params)), body(std::move(body)) {
-        }
-        FuncDefNode(TypeNodePtr returnType, std::string name, StmtNodePtr body) :
-            returnType(std::move(returnType)), name(std::move(name)), params(), body(std::move(body)) {}
-        ASTNodeGen traverse();
+        FuncDefNode(TypeNodePtr returnType, Common::Symbol name, std::vector<ParamsElem> params, StmtNodePtr body) :
+            returnType(std::move(returnType)), name(name), params(std::move(params)), body(std::move(body)) {}
+        FuncDefNode(TypeNodePtr returnType, Common::Symbol name, StmtNodePtr body) :
+            returnType(std::move(returnType)), name(name), params(), body(std::move(body)) {}
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
@@ -309,21 +351,22 @@ namespace TinyCobalt::AST {
             FieldsElemNode(Args &&...args) : VariableDefNode(std::forward<Args>(args)...) {}
         };
         using FieldsElem = std::shared_ptr<FieldsElemNode>;
-        const std::string name;
+        const Common::Symbol name;
         const std::vector<FieldsElem> fields;
-        StructDefNode(std::string name, std::vector<FieldsElem> fields) :
-            name(std::move(name)), fields(std::move(fields)) {}
-        explicit StructDefNode(std::string name) : name(std::move(name)), fields() {}
-        ASTNodeGen traverse();
+        StructDefNode(Common::Symbol name, std::vector<FieldsElem> fields) : name(name), fields(std::move(fields)) {}
+        explicit StructDefNode(Common::Symbol name) : name(name), fields() {}
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
 
     struct AliasDefNode : public EnableThisPointer<AliasDefNode> {
-        const std::string name;
+        const Common::Symbol name;
         const TypeNodePtr type;
-        AliasDefNode(std::string name, TypeNodePtr type) : name(std::move(name)), type(std::move(type)) {}
-        ASTNodeGen traverse();
+        AliasDefNode(Common::Symbol name, TypeNodePtr type) : name(name), type(std::move(type)) {}
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
@@ -331,13 +374,15 @@ namespace TinyCobalt::AST {
     struct ExprStmtNode : public EnableThisPointer<ExprStmtNode> {
         const ExprNodePtr expr;
         explicit ExprStmtNode(ExprNodePtr expr) : expr(std::move(expr)) {}
-        ASTNodeGen traverse();
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
 
     struct EmptyStmtNode : public EnableThisPointer<EmptyStmtNode> {
-        ASTNodeGen traverse();
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
         void stmtFlag() {}
         Common::JSON toJSON() const;
     };
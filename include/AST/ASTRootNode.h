@@ -5,19 +5,23 @@
 #ifndef TINY_COBALT_INCLUDE_AST_ASTROOTNODE_H_
 #define TINY_COBALT_INCLUDE_AST_ASTROOTNODE_H_
 
+#include <cstddef>
+#include <memory>
+#include <vector>
 #include "AST/ASTNode.h"
+#include "AST/NodeKind.h"
 #include "AST/StmtNode.h"
 
 namespace TinyCobalt::AST {
 
     struct ASTRootNode : public EnableThisPointer<ASTRootNode> {
+        // Storage owned by the compilation that produced this tree (e.g. the symbol pool the names point into).
+        // Declared before children so that it outlives them during destruction.
+        std::vector<std::shared_ptr<const void>> resources;
         std::vector<StmtNodePtr> children;
         explicit ASTRootNode(std::vector<StmtNodePtr> children) : children(std::move(children)) {}
-        ASTNodeGen traverse() {
-            for (const auto &child: children) {
-                co_yield child;
-            }
-        }
+        std::size_t childCount() const { return children.size(); }
+        ASTNodePtr child(std::size_t index) const { return children.at(index); }
         Common::JSON toJSON() const {
             Common::JSON json;
             json["type"] = "ASTRoot";
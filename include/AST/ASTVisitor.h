@@ -9,8 +9,11 @@
 #include "Common/Utility.h"
 
 #include <concepts>
+#include <cstddef>
 #include <proxy.h>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace TinyCobalt::AST {
 
@@ -106,55 +109,93 @@ namespace TinyCobalt::AST {
         requires ASTVisitorMiddlewareConcept<Middleware>
     class BaseASTVisitor {
     public:
+        /**
+         * Visit the subtree of node in depth-first order. The nodes being visited are kept on an explicit stack rather
+         * than the call stack, so arbitrarily deep trees can be visited. The stack is reused across calls. Only the
+         * visit is iterative: destroying such a tree, flattening it or dumping its JSON still recurses per level.
+         *
+         * Break from beforeSubtree() skips the subtree including afterSubtree(). Continue and Break from beforeChild()
+         * and afterChild() skip the rest of the child or of the children respectively; afterSubtree() is still called.
+         * Exit stops the whole visit.
+         */
         VisitorState visit(ASTNodePtr node) {
             if (!node)
                 return VisitorState::EmptyNode;
-            switch (middleware_.beforeSubtree(node)) {
-                case VisitorState::Break:
-                    return VisitorState::Normal;
-                case VisitorState::Exit:
-                    return VisitorState::Exit;
-                default:
-                    break;
-            }
-            for (auto child: node->traverse()) {
+            stack_.clear();
+            if (enter(std::move(node)) == VisitorState::Exit)
+                return exit();
+            while (!stack_.empty()) {
+                auto &frame = stack_.back();
+                if (frame.child) {
+                    // The subtree of the child has been visited.
+                    auto child = std::exchange(frame.child, nullptr);
+                    switch (middleware_.afterChild(frame.node, std::move(child))) {
+                        case VisitorState::Break:
+                            frame.next = frame.size;
+                            break;
+                        case VisitorState::Exit:
+                            return exit();
+                        default:
+                            break;
+                    }
+                }
+                if (frame.next == frame.size) {
+                    auto done = std::move(frame.node);
+                    stack_.pop_back();
+                    if (middleware_.afterSubtree(std::move(done)) == VisitorState::Exit)
+                        return exit();
+                    continue;
+                }
+                auto child = frame.node->child(frame.next++);
                 if (!child)
                     continue;
-                switch (middleware_.beforeChild(node, child)) {
+                switch (middleware_.beforeChild(frame.node, child)) {
                     case VisitorState::Continue:
                         continue;
                     case VisitorState::Break:
-                        goto BreakTag;
-                    case VisitorState::Exit:
-                        return VisitorState::Exit;
-                    default:
-                        break;
-                }
-                if (this->visit(child) == VisitorState::Exit) {
-                    return VisitorState::Exit;
-                }
-                switch (middleware_.afterChild(node, child)) {
-                    case VisitorState::Continue:
+                        frame.next = frame.size;
                         continue;
-                    case VisitorState::Break:
-                        goto BreakTag;
                     case VisitorState::Exit:
-                        return VisitorState::Exit;
+                        return exit();
                     default:
                         break;
                 }
+                frame.child = child;
+                // This may grow the stack, so frame is not used afterwards.
+                if (enter(std::move(child)) == VisitorState::Exit)
+                    return exit();
             }
-        BreakTag:
-            switch (middleware_.afterSubtree(node)) {
-                case VisitorState::Exit:
-                    return VisitorState::Exit;
-                default:
-                    return VisitorState::Normal;
-            }
+            return VisitorState::Normal;
         }
 
+        Middleware &middleware() { return middleware_; }
+
     private:
+        struct Frame {
+            ASTNodePtr node;
+            // The child whose subtree is being visited, until afterChild() is called for it.
+            ASTNodePtr child;
+            std::size_t next;
+            std::size_t size;
+        };
+
+        // Call beforeSubtree() and push the node unless its subtree is skipped.
+        VisitorState enter(ASTNodePtr node) {
+            auto state = middleware_.beforeSubtree(node);
+            if (state != VisitorState::Break && state != VisitorState::Exit) {
+                auto size = node->childCount();
+                stack_.push_back(Frame{std::move(node), nullptr, 0, size});
+            }
+            return state;
+        }
+
+        VisitorState exit() {
+            stack_.clear();
+            return VisitorState::Exit;
+        }
+
         Middleware middleware_{};
+        std::vector<Frame> stack_;
     };
 
 } // namespace TinyCobalt::AST
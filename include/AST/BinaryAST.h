@@ -0,0 +1,154 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_AST_BINARYAST_H_
+#define TINY_COBALT_INCLUDE_AST_BINARYAST_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AST/ASTNode.h"
+#include "AST/ASTRootNode.h"
+#include "AST/FlatAST.h"
+#include "AST/NodeKind.h"
+#include "Common/JSON.h"
+#include "Common/Location.h"
+#include "LexerParser/SourceBuffer.h"
+
+namespace TinyCobalt::AST {
+
+    class BinaryAST;
+
+    /**
+     * A node of a BinaryAST, decoded from its record whenever it is accessed. Like FlatNode, it has the same interface
+     * as the node structs, so that a BinaryASTNodePtr is an ASTNodePtr and a mapped file can be visited without
+     * materializing it. Children are yielded in the same order as by the corresponding node struct, and each is
+     * found in constant time. Like a FlatNode, it is ignored by matchers that dispatch on the node structs.
+     */
+    class BinaryASTNode {
+    public:
+        BinaryASTNode() = default;
+        BinaryASTNode(const BinaryAST *ast, NodeId id) : ast_(ast), id_(id) {}
+
+        const BinaryAST &ast() const { return *ast_; }
+        NodeId id() const { return id_; }
+        NodeKind kind() const;
+        Common::Location location() const;
+
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        ASTNodeGen traverse() const { return traverseChildren(*this); }
+        // The record of the node in the buffer.
+        void *thisPointer() const;
+        // Same output as the toJSON() of the node structs.
+        Common::JSON toJSON() const;
+
+    private:
+        const BinaryAST *ast_ = nullptr;
+        NodeId id_ = kNullNode;
+    };
+
+    // A handle to a node of a BinaryAST. It fits in a proxy without allocation.
+    class BinaryASTNodePtr {
+    public:
+        BinaryASTNodePtr() = default;
+        BinaryASTNodePtr(const BinaryAST *ast, NodeId id) : node_(ast, id) {}
+
+        BinaryASTNode &operator*() const { return node_; }
+        BinaryASTNode *operator->() const { return &node_; }
+        explicit operator bool() const { return node_.id() != kNullNode; }
+
+    private:
+        mutable BinaryASTNode node_;
+    };
+
+    static_assert(ASTNodePtrConcept<BinaryASTNodePtr>, "BinaryASTNodePtr is not an ASTNodePtr");
+
+    /**
+     * A serialized AST, e.g. a module cached between build steps. The file is a header, a string table, an index of
+     * node offsets and the node records. A record is the kind tag followed by varints: the location, the fields of the
+     * node and its children. A single child is stored as the zigzag-encoded difference between the ids of the parent
+     * and the child, or 0 if it is missing, so nearby children take a byte. A list of children is its size followed by
+     * the ids at a fixed width, so that any child of a node is found without decoding the others. Names are indices
+     * into the string table, which holds each distinct name once.
+     *
+     * The ids are those of the FlatAST the file was written from. Opening a file only validates the header; strings
+     * and records are read in place from the buffer, which is usually a mapping of the file, when they are accessed.
+     * The nodes can be walked in place through root(), or built into a pointer tree by materialize(). Fixed-size
+     * fields use the host byte order, so files are not portable.
+     */
+    class BinaryAST {
+    public:
+        // Bumped whenever the record layout changes.
+        static constexpr std::uint32_t kVersion = 2;
+
+        /**
+         * Serialize a tree in one pass over its nodes.
+         */
+        static std::vector<char> serialize(const FlatAST &ast);
+
+        /**
+         * Serialize a tree to path. The file is replaced atomically. Return false if it cannot be written.
+         */
+        static bool store(const FlatAST &ast, const std::string &path);
+
+        /**
+         * Open a serialized tree.
+         * @throw std::runtime_error if the buffer is not a tree of this version.
+         */
+        explicit BinaryAST(LexerParser::SourceBuffer buffer);
+
+        // Handles point to the BinaryAST, so it stays where it was opened.
+        BinaryAST(const BinaryAST &) = delete;
+        BinaryAST &operator=(const BinaryAST &) = delete;
+
+        /**
+         * Map the file at path and open it.
+         * @throw std::system_error if the file cannot be mapped.
+         * @throw std::runtime_error if the file is not a tree of this version.
+         */
+        static BinaryAST map(const std::string &path);
+
+        // Handles to the nodes, which must not outlive the BinaryAST. A malformed record throws std::runtime_error
+        // when it is accessed.
+        BinaryASTNodePtr root() const { return {this, 0}; }
+        BinaryASTNodePtr node(NodeId id) const { return {this, id}; }
+        // The node, or an empty proxy for kNullNode, as the node structs yield missing children.
+        ASTNodePtr child(NodeId id) const;
+
+        // Number of nodes. The root has id 0.
+        std::size_t size() const { return nodes_; }
+        NodeKind kind(NodeId id) const;
+        Common::Location location(NodeId id) const;
+        // The bytes of a node record, from its kind tag to the end of the records.
+        std::span<const char> record(NodeId id) const;
+
+        std::size_t strings() const { return strings_; }
+        std::string_view string(std::uint32_t index) const;
+
+        /**
+         * Build the pointer tree. Names are interned into a new pool kept in the resources of the root.
+         * @throw std::runtime_error if a record is malformed.
+         */
+        ASTRootPtr materialize() const;
+
+    private:
+        LexerParser::SourceBuffer buffer_;
+        std::uint32_t nodes_ = 0;
+        std::uint32_t strings_ = 0;
+        // Sections of buffer_.
+        const char *string_offsets_ = nullptr;
+        const char *string_data_ = nullptr;
+        std::size_t string_size_ = 0;
+        const char *node_offsets_ = nullptr;
+        const char *records_ = nullptr;
+        std::size_t records_size_ = 0;
+    };
+
+} // namespace TinyCobalt::AST
+
+#endif // TINY_COBALT_INCLUDE_AST_BINARYAST_H_
@@ -0,0 +1,248 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_AST_FLATAST_H_
+#define TINY_COBALT_INCLUDE_AST_FLATAST_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+#include "AST/ASTNode.h"
+#include "AST/ASTNodeDecl.h"
+#include "AST/ASTRootNode.h"
+#include "AST/NodeKind.h"
+#include "Common/JSON.h"
+#include "Common/Location.h"
+#include "Common/Symbol.h"
+
+namespace TinyCobalt::AST {
+
+    // Index of a node in a FlatAST.
+    using NodeId = std::uint32_t;
+    inline constexpr NodeId kNullNode = std::numeric_limits<NodeId>::max();
+
+    class FlatAST;
+
+    /**
+     * A node of a FlatAST. It has the same interface as the node structs, so that a FlatNodePtr is an ASTNodePtr.
+     * Children are yielded in the same order as by the corresponding node struct.
+     */
+    class FlatNode {
+    public:
+        FlatNode() = default;
+        FlatNode(const FlatAST *ast, NodeId id) : ast_(ast), id_(id) {}
+
+        const FlatAST &ast() const { return *ast_; }
+        NodeId id() const { return id_; }
+        NodeKind kind() const;
+        const Common::Location &location() const;
+
+        std::size_t childCount() const;
+        ASTNodePtr child(std::size_t index) const;
+        ASTNodeGen traverse() const { return traverseChildren(*this); }
+        // The payload record of the node.
+        void *thisPointer() const;
+        Common::JSON toJSON() const;
+
+    private:
+        const FlatAST *ast_ = nullptr;
+        NodeId id_ = kNullNode;
+    };
+
+    // A handle to a node of a FlatAST. It fits in a proxy without allocation.
+    class FlatNodePtr {
+    public:
+        FlatNodePtr() = default;
+        FlatNodePtr(const FlatAST *ast, NodeId id) : node_(ast, id) {}
+
+        FlatNode &operator*() const { return node_; }
+        FlatNode *operator->() const { return &node_; }
+        explicit operator bool() const { return node_.id() != kNullNode; }
+
+    private:
+        mutable FlatNode node_;
+    };
+
+    static_assert(ASTNodePtrConcept<FlatNodePtr>, "FlatNodePtr is not an ASTNodePtr");
+
+    /**
+     * Struct-of-arrays storage of an AST. Every node has a 32-bit id; its kind and location live in arrays indexed by
+     * id, and its payload in an array of records of its kind. Children are ids, and child lists are ranges of one
+     * shared id array. Compared to the tree of shared_ptr nodes, there is no per-node allocation, control block or
+     * proxy, and a pass over all nodes of a kind reads one contiguous array.
+     *
+     * A FlatAST is built from a tree, either at once or one top-level statement at a time, so that a streamed tree
+     * never exists in full. Names are symbols of the pool of the parser, which resources must keep alive.
+     *
+     * A FlatNodePtr is an ASTNodePtr, so traversals that only use the node interface, e.g. BaseASTVisitor middlewares
+     * and JSONWriter, work on a FlatAST. Matchers that dispatch on the node structs, such as DeclMatcher and
+     * TypeAnalyzer, find no candidate for a FlatNode and do nothing with it.
+     */
+    class FlatAST {
+    public:
+        // A range of the shared child list array.
+        struct List {
+            std::uint32_t begin = 0;
+            std::uint32_t size = 0;
+        };
+
+        struct SimpleTypeRecord {
+            Common::Symbol name;
+        };
+        struct FuncTypeRecord {
+            NodeId returnType;
+            List paramTypes;
+        };
+        // Template arguments are type or ConstExpr nodes.
+        struct ComplexTypeRecord {
+            Common::Symbol templateName;
+            List templateArgs;
+        };
+        struct ConstExprRecord {
+            ConstExprNode::Value value;
+            ConstExprType type;
+        };
+        struct VariableRecord {
+            Common::Symbol name;
+        };
+        struct BinaryRecord {
+            BinaryOp op;
+            NodeId lhs;
+            NodeId rhs;
+        };
+        struct UnaryRecord {
+            UnaryOp op;
+            NodeId operand;
+        };
+        struct MultiaryRecord {
+            MultiaryOp op;
+            NodeId object;
+            List operands;
+        };
+        struct CastRecord {
+            CastType op;
+            NodeId type;
+            NodeId operand;
+        };
+        struct ConditionRecord {
+            NodeId condition;
+            NodeId trueBranch;
+            NodeId falseBranch;
+        };
+        struct MemberRecord {
+            BinaryOp op;
+            NodeId object;
+            Common::Symbol member;
+        };
+        struct IfRecord {
+            NodeId condition;
+            NodeId thenStmt;
+            NodeId elseStmt;
+        };
+        struct WhileRecord {
+            NodeId condition;
+            NodeId body;
+        };
+        struct ForRecord {
+            NodeId init;
+            NodeId condition;
+            NodeId step;
+            NodeId body;
+        };
+        struct ReturnRecord {
+            NodeId value;
+        };
+        struct BlockRecord {
+            List stmts;
+        };
+        struct BreakRecord {};
+        struct ContinueRecord {};
+        // Also used for function parameters and struct fields.
+        struct VariableDefRecord {
+            NodeId type;
+            Common::Symbol name;
+            NodeId init;
+        };
+        struct FuncDefRecord {
+            NodeId returnType;
+            Common::Symbol name;
+            List params;
+            NodeId body;
+        };
+        struct StructDefRecord {
+            Common::Symbol name;
+            List fields;
+        };
+        struct AliasDefRecord {
+            Common::Symbol name;
+            NodeId type;
+        };
+        struct ExprStmtRecord {
+            NodeId expr;
+        };
+        struct EmptyStmtRecord {};
+        // The children of the root are kept apart, so that statements can be appended after their subtrees.
+        struct ASTRootRecord {};
+
+        // An empty tree. The root has id 0.
+        FlatAST();
+        // Flatten a whole tree and keep its resources.
+        explicit FlatAST(const ASTRootPtr &root);
+
+        // Handles point to the tree, so it stays where it was built.
+        FlatAST(const FlatAST &) = delete;
+        FlatAST &operator=(const FlatAST &) = delete;
+
+        // Flatten a statement and append it to the children of the root. Return its id.
+        NodeId append(const StmtNodePtr &stmt);
+
+        FlatNodePtr root() const { return {this, 0}; }
+        FlatNodePtr node(NodeId id) const { return {this, id}; }
+        // The node, or an empty proxy for kNullNode, as the node structs yield missing children.
+        ASTNodePtr child(NodeId id) const;
+
+        std::size_t size() const { return kinds_.size(); }
+        NodeKind kind(NodeId id) const { return kinds_[id]; }
+        const Common::Location &location(NodeId id) const { return locations_[id]; }
+        std::span<const NodeId> list(List list) const { return {lists_.data() + list.begin, list.size}; }
+        std::span<const NodeId> children() const { return topLevel_; }
+
+        // Payload of a node of the kind, e.g. getBinary(id).
+#define REG_FLAT_GETTER(Name, ...)                                                                                     \
+    const Name##Record &get##Name(NodeId id) const { return Name##Records_[indices_[id]]; }
+        TINY_COBALT_AST_NODES(REG_FLAT_GETTER)
+#undef REG_FLAT_GETTER
+
+        // Bytes held by the arrays, excluding names and resources.
+        std::size_t memoryUsage() const;
+
+        // Storage the names point into, e.g. the resources of the flattened roots.
+        std::vector<std::shared_ptr<const void>> resources;
+
+    private:
+        template<typename Record>
+        NodeId addNode(NodeKind kind, std::vector<Record> &records, Record record,
+                       const Common::Location &location);
+        template<typename P>
+        NodeId add(const P &node);
+        template<typename Range>
+        List addList(const Range &nodes);
+
+        std::vector<NodeKind> kinds_;
+        // Index of the payload of each node in the record array of its kind.
+        std::vector<std::uint32_t> indices_;
+        std::vector<Common::Location> locations_;
+        std::vector<NodeId> lists_;
+        std::vector<NodeId> topLevel_;
+#define REG_FLAT_RECORDS(Name, ...) std::vector<Name##Record> Name##Records_;
+        TINY_COBALT_AST_NODES(REG_FLAT_RECORDS)
+#undef REG_FLAT_RECORDS
+    };
+
+} // namespace TinyCobalt::AST
+
+#endif // TINY_COBALT_INCLUDE_AST_FLATAST_H_
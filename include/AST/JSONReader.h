@@ -0,0 +1,42 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_AST_JSONREADER_H_
+#define TINY_COBALT_INCLUDE_AST_JSONREADER_H_
+
+#include <istream>
+#include <string_view>
+#include "AST/ASTRootNode.h"
+#include "Common/JSON.h"
+
+namespace TinyCobalt::AST {
+
+    /**
+     * Build a tree from the JSON written by toJSON() or JSONWriter. The text is read as a stream of SAX events and
+     * each node is built as soon as its object is closed, so no JSON value of the document is held in memory. Keys
+     * may come in any order.
+     *
+     * Nodes are allocated from an arena and names are interned into a pool, like the nodes of the parser; each node
+     * keeps both alive, and so does the root in its resources. The JSON has no locations, so every node has an empty
+     * one.
+     */
+    class JSONReader {
+    public:
+        /**
+         * Read a document whose top-level object is an ASTRoot.
+         * @throw std::runtime_error if the text is not valid JSON or not a tree.
+         */
+        static ASTRootPtr read(std::istream &is);
+        static ASTRootPtr read(std::string_view text);
+    };
+
+} // namespace TinyCobalt::AST
+
+namespace TinyCobalt::Common {
+    // Same as AST::JSONReader for a document that has already been parsed.
+    template<>
+    AST::ASTRootPtr fromJSON<AST::ASTRootPtr>(const JSON &obj);
+} // namespace TinyCobalt::Common
+
+#endif // TINY_COBALT_INCLUDE_AST_JSONREADER_H_
@@ -0,0 +1,43 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_AST_JSONWRITER_H_
+#define TINY_COBALT_INCLUDE_AST_JSONWRITER_H_
+
+#include <ostream>
+#include <string_view>
+#include "AST/ASTNode.h"
+
+namespace TinyCobalt::AST {
+
+    /**
+     * Write the JSON of a tree directly to a stream as it is walked. The output is the same as toJSON().dump(), i.e.
+     * compact with the keys of each object in sorted order, but no JSON value is built, so the extra memory is
+     * bounded by the depth of the tree. Use this for dumps of large inputs; toJSON() stays for tests and small trees.
+     *
+     * Unlike dump(), strings are written byte by byte and are not checked to be valid UTF-8. Nodes other than the node
+     * structs, e.g. a FlatNodePtr, are written through their toJSON(), which builds a JSON value of their subtree.
+     */
+    class JSONWriter {
+    public:
+        explicit JSONWriter(std::ostream &os) : os_(os) {}
+
+        // Write a node and its subtree. A null node is written as null.
+        JSONWriter &write(const ASTNodePtr &node);
+
+    private:
+        template<typename P>
+        void value(const P &node);
+        template<typename L>
+        void list(const L &nodes);
+        void string(std::string_view text);
+        // Write "key": after the opening brace if it is the first key of the object, or after a comma.
+        void key(std::string_view name, bool first = false);
+
+        std::ostream &os_;
+    };
+
+} // namespace TinyCobalt::AST
+
+#endif // TINY_COBALT_INCLUDE_AST_JSONWRITER_H_
@@ -0,0 +1,181 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_AST_MIDDLEWAREPIPELINE_H_
+#define TINY_COBALT_INCLUDE_AST_MIDDLEWAREPIPELINE_H_
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include "AST/ASTNode.h"
+#include "AST/ASTVisitor.h"
+
+namespace TinyCobalt::AST {
+
+    /**
+     * Fuse several middlewares into one, so that a single walk of the tree does the work of one walk per middleware.
+     * Every call is forwarded to the stages in the order they are listed, for the "after" calls as well.
+     *
+     * Each stage sees exactly the calls it would see if it were visiting the tree on its own: the states a stage
+     * returns only skip the calls of that stage, and the other stages go on. The pipeline tells the visitor to skip
+     * a subtree or the rest of the children only when no stage is left to visit them, and returns Exit once every
+     * stage has exited.
+     *
+     * A stage that throws leaves the pipeline in the middle of a visit, so the whole visitor should be dropped then.
+     */
+    template<typename... Middlewares>
+        requires(sizeof...(Middlewares) > 0 && (ASTVisitorMiddlewareConcept<Middlewares> && ...))
+    class MiddlewarePipeline {
+    public:
+        VisitorState beforeSubtree(ASTNodePtr node) {
+            auto level = nodeLevel();
+            forward(Call::BeforeSubtree, level, [&](auto &stage) { return stage.beforeSubtree(node); });
+            auto state = combine(level);
+            if (state == VisitorState::Normal)
+                ++depth_;
+            return finish(state);
+        }
+
+        VisitorState afterSubtree(ASTNodePtr node) {
+            --depth_;
+            forward(Call::AfterSubtree, nodeLevel(), [&](auto &stage) { return stage.afterSubtree(node); });
+            return finish(allExited() ? VisitorState::Exit : VisitorState::Normal);
+        }
+
+        VisitorState beforeChild(ASTNodePtr node, ASTNodePtr child) {
+            auto level = childLevel();
+            forward(Call::BeforeChild, level, [&](auto &stage) { return stage.beforeChild(node, child); });
+            return finish(combine(level));
+        }
+
+        VisitorState afterChild(ASTNodePtr node, ASTNodePtr child) {
+            auto level = childLevel();
+            forward(Call::AfterChild, level, [&](auto &stage) { return stage.afterChild(node, child); });
+            return finish(combine(level));
+        }
+
+        template<std::size_t Index>
+        auto &stage() {
+            return std::get<Index>(stages_);
+        }
+
+        template<typename Middleware>
+        Middleware &stage() {
+            return std::get<Middleware>(stages_);
+        }
+
+    private:
+        enum class Call { BeforeSubtree, AfterSubtree, BeforeChild, AfterChild };
+
+        // Why a stage is not being called, and from which level on.
+        struct Suspension {
+            enum class Mode {
+                None,
+                // Break from beforeSubtree(): the subtree and its afterSubtree() are skipped.
+                Subtree,
+                // Continue from beforeChild(): the subtree of the child and its afterChild() are skipped.
+                Child,
+                // Break from beforeChild() or afterChild(): the rest of the children are skipped.
+                Children,
+                Exited,
+            };
+            Mode mode = Mode::None;
+            std::size_t level = 0;
+        };
+
+        using Mode = typename Suspension::Mode;
+
+        static constexpr std::size_t kStageCount = sizeof...(Middlewares);
+
+        // The calls of a node come at odd levels, and the calls between a node and its children at the even level
+        // right below. A stage suspended at some level skips every call deeper than that.
+        std::size_t nodeLevel() const { return 2 * depth_ + 1; }
+        std::size_t childLevel() const { return 2 * depth_; }
+
+        template<typename Func>
+        void forward(Call call, std::size_t level, Func &&func) {
+            [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+                ((resume(suspended_[Index], call, level)
+                          ? suspend(suspended_[Index], call, level, func(std::get<Index>(stages_)))
+                          : void()),
+                 ...);
+            }(std::index_sequence_for<Middlewares...>{});
+        }
+
+        // Whether the call goes to a stage with the suspension, which is lifted once the stage is past the skip.
+        static bool resume(Suspension &suspension, Call call, std::size_t level) {
+            switch (suspension.mode) {
+                case Mode::None:
+                    return true;
+                case Mode::Exited:
+                    return false;
+                default:
+                    break;
+            }
+            if (level > suspension.level)
+                return false;
+            if (level == suspension.level) {
+                if (suspension.mode == Mode::Children)
+                    return false;
+                if (suspension.mode == Mode::Subtree || call == Call::AfterChild) {
+                    // This is the last call the stage skips.
+                    suspension = {};
+                    return false;
+                }
+            }
+            suspension = {};
+            return true;
+        }
+
+        static void suspend(Suspension &suspension, Call call, std::size_t level, VisitorState state) {
+            if (state == VisitorState::Exit)
+                suspension = {Mode::Exited, level};
+            else if (call == Call::BeforeSubtree && state == VisitorState::Break)
+                suspension = {Mode::Subtree, level};
+            else if (call == Call::BeforeChild && state == VisitorState::Continue)
+                suspension = {Mode::Child, level};
+            else if ((call == Call::BeforeChild || call == Call::AfterChild) && state == VisitorState::Break)
+                suspension = {Mode::Children, level};
+        }
+
+        // What the visitor is told to do after a call at the level.
+        VisitorState combine(std::size_t level) const {
+            bool next_child = false;
+            for (const auto &suspension: suspended_) {
+                if (suspension.mode == Mode::None)
+                    return VisitorState::Normal;
+                if (suspension.mode == Mode::Child && suspension.level == level)
+                    next_child = true;
+            }
+            if (allExited())
+                return VisitorState::Exit;
+            return next_child ? VisitorState::Continue : VisitorState::Break;
+        }
+
+        bool allExited() const {
+            for (const auto &suspension: suspended_)
+                if (suspension.mode != Mode::Exited)
+                    return false;
+            return true;
+        }
+
+        // The visit is over once it has exited or left the root, so the next one starts afresh.
+        VisitorState finish(VisitorState state) {
+            if (state == VisitorState::Exit || depth_ == 0) {
+                depth_ = 0;
+                suspended_ = {};
+            }
+            return state;
+        }
+
+        std::tuple<Middlewares...> stages_;
+        std::array<Suspension, kStageCount> suspended_{};
+        // The number of nodes entered on the path from the root.
+        std::size_t depth_ = 0;
+    };
+
+} // namespace TinyCobalt::AST
+
+#endif // TINY_COBALT_INCLUDE_AST_MIDDLEWAREPIPELINE_H_
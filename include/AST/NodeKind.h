@@ -0,0 +1,43 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_AST_NODEKIND_H_
+#define TINY_COBALT_INCLUDE_AST_NODEKIND_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "AST/ASTNode.h"
+#include "AST/ExprNode.h"
+#include "AST/StmtNode.h"
+#include "AST/TypeNode.h"
+
+namespace TinyCobalt::AST {
+
+    // Kinds of AST nodes, in the order of TINY_COBALT_AST_NODES.
+    enum class NodeKind : std::uint8_t {
+#define REG_NODE_KIND(Name, ...) Name,
+        TINY_COBALT_AST_NODES(REG_NODE_KIND)
+#undef REG_NODE_KIND
+    };
+
+    inline constexpr std::size_t kNodeKindCount = 0
+#define REG_NODE_KIND(Name, ...) +1
+            TINY_COBALT_AST_NODES(REG_NODE_KIND)
+#undef REG_NODE_KIND
+            ;
+
+    struct ASTRootNode;
+
+    // EnableThisPointer gives each node struct its kind as kKind. Node types derived from a node struct, like the
+    // parameters of a function, share the kind of their base.
+#define REG_NODE_KIND_OF(Name, ...)                                                                                    \
+    template<>                                                                                                         \
+    struct NodeKindOf<Name##Node> : std::integral_constant<NodeKind, NodeKind::Name> {};
+    TINY_COBALT_AST_NODES(REG_NODE_KIND_OF)
+#undef REG_NODE_KIND_OF
+
+} // namespace TinyCobalt::AST
+
+#endif // TINY_COBALT_INCLUDE_AST_NODEKIND_H_
@@ -0,0 +1,161 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_COMMON_ARENA_H_
+#define TINY_COBALT_INCLUDE_COMMON_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace TinyCobalt::Common {
+
+    /**
+     * A bump allocator. Memory is carved out of large chunks and is only returned when the arena itself is destroyed,
+     * which releases every chunk at once. An arena is not thread-safe; use one per compilation.
+     */
+    class Arena {
+    public:
+        static constexpr std::size_t kDefaultChunkSize = 64 * 1024;
+
+        explicit Arena(std::size_t chunk_size = kDefaultChunkSize) : chunk_size_(chunk_size) {}
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        void *allocate(std::size_t size, std::size_t align = alignof(std::max_align_t)) {
+            auto space = static_cast<std::size_t>(end_ - cursor_);
+            void *ptr = cursor_;
+            if (cursor_ && std::align(align, size, ptr, space)) {
+                cursor_ = static_cast<std::byte *>(ptr) + size;
+                allocated_ += size;
+                return ptr;
+            }
+            // Large requests get a chunk of their own so that the current chunk stays in use.
+            if (size + align > chunk_size_ / 4) {
+                chunks_.push_back(std::make_unique<std::byte[]>(size + align));
+                ptr = chunks_.back().get();
+                space = size + align;
+                allocated_ += size;
+                return std::align(align, size, ptr, space);
+            }
+            chunks_.push_back(std::make_unique<std::byte[]>(chunk_size_));
+            cursor_ = chunks_.back().get();
+            end_ = cursor_ + chunk_size_;
+            return allocate(size, align);
+        }
+
+        template<typename T>
+        T *allocate(std::size_t count = 1) {
+            return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        // Bytes handed out so far, excluding alignment padding.
+        std::size_t allocated() const { return allocated_; }
+
+    private:
+        std::size_t chunk_size_;
+        std::vector<std::unique_ptr<std::byte[]>> chunks_;
+        std::byte *cursor_ = nullptr;
+        std::byte *end_ = nullptr;
+        std::size_t allocated_ = 0;
+    };
+
+    /**
+     * Standard allocator adaptor over an Arena. deallocate() is a no-op, the memory goes away with the arena. The
+     * arena must outlive every object allocated through it.
+     */
+    template<typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(Arena *arena) noexcept : arena_(arena) {}
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena_(other.arena()) {}
+
+        T *allocate(std::size_t count) { return arena_->allocate<T>(count); }
+        void deallocate(T *, std::size_t) noexcept {}
+
+        Arena *arena() const noexcept { return arena_; }
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U> &other) const noexcept {
+            return arena_ == other.arena();
+        }
+
+    private:
+        Arena *arena_;
+    };
+
+    /**
+     * Standard allocator adaptor sharing ownership of an Arena. The control block of std::allocate_shared holds a copy
+     * of its allocator, so each object made that way keeps the arena alive until the object itself is released.
+     */
+    template<typename T>
+    class SharedArenaAllocator {
+    public:
+        using value_type = T;
+
+        explicit SharedArenaAllocator(std::shared_ptr<Arena> arena) noexcept : arena_(std::move(arena)) {}
+        template<typename U>
+        SharedArenaAllocator(const SharedArenaAllocator<U> &other) noexcept : arena_(other.arena()) {}
+
+        T *allocate(std::size_t count) { return arena_->allocate<T>(count); }
+        void deallocate(T *, std::size_t) noexcept {}
+
+        const std::shared_ptr<Arena> &arena() const noexcept { return arena_; }
+
+        template<typename U>
+        bool operator==(const SharedArenaAllocator<U> &other) const noexcept {
+            return arena_ == other.arena();
+        }
+
+    private:
+        std::shared_ptr<Arena> arena_;
+    };
+
+    /**
+     * The heap-backed counterpart of SharedArenaAllocator: objects made by std::allocate_shared with it are freed one
+     * by one, and each keeps owner alive until it is released.
+     */
+    template<typename T>
+    class OwningAllocator {
+    public:
+        using value_type = T;
+
+        explicit OwningAllocator(std::shared_ptr<const void> owner) noexcept : owner_(std::move(owner)) {}
+        template<typename U>
+        OwningAllocator(const OwningAllocator<U> &other) noexcept : owner_(other.owner()) {}
+
+        T *allocate(std::size_t count) { return std::allocator<T>().allocate(count); }
+        void deallocate(T *ptr, std::size_t count) noexcept { std::allocator<T>().deallocate(ptr, count); }
+
+        const std::shared_ptr<const void> &owner() const noexcept { return owner_; }
+
+        template<typename U>
+        bool operator==(const OwningAllocator<U> &) const noexcept {
+            return true;
+        }
+
+    private:
+        std::shared_ptr<const void> owner_;
+    };
+
+    /**
+     * Make an arena which keeps owner alive as long as the arena is, e.g. the pool of the names its objects point to.
+     */
+    inline std::shared_ptr<Arena> makeArena(std::shared_ptr<const void> owner) {
+        struct Holder {
+            Arena arena;
+            std::shared_ptr<const void> owner;
+        };
+        auto holder = std::make_shared<Holder>();
+        holder->owner = std::move(owner);
+        return {holder, &holder->arena};
+    }
+
+} // namespace TinyCobalt::Common
+
+#endif // TINY_COBALT_INCLUDE_COMMON_ARENA_H_
@@ -0,0 +1,61 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_COMMON_ATOMICFILE_H_
+#define TINY_COBALT_INCLUDE_COMMON_ATOMICFILE_H_
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace TinyCobalt::Common {
+
+    /**
+     * Replace the file at path with what write puts into the stream it is given. The content goes to a temporary
+     * file next to path, which is renamed over it once complete, so that a reader never sees a partial file and
+     * concurrent writers of the same file do not interleave. Missing parent directories are created.
+     * @return false if the file cannot be written, in which case path is left as it was.
+     */
+    template<typename Write>
+        requires std::invocable<Write &, std::ostream &>
+    bool writeFileAtomically(const std::filesystem::path &path, Write &&write) {
+        std::error_code ec;
+        if (path.has_parent_path())
+            std::filesystem::create_directories(path.parent_path(), ec);
+        if (ec)
+            return false;
+        // A name unique to this writer.
+        auto tag = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                   static_cast<std::size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        auto temp = path;
+        temp += "." + std::to_string(tag) + ".tmp";
+        {
+            std::ofstream ofs(temp, std::ios::binary | std::ios::trunc);
+            if (!ofs)
+                return false;
+            write(static_cast<std::ostream &>(ofs));
+            if (!ofs.flush()) {
+                ofs.close();
+                std::filesystem::remove(temp, ec);
+                return false;
+            }
+        }
+        std::filesystem::rename(temp, path, ec);
+        if (ec) {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace TinyCobalt::Common
+
+#endif // TINY_COBALT_INCLUDE_COMMON_ATOMICFILE_H_
@@ -9,6 +9,7 @@
 #include <nlohmann/json.hpp>
 #include <proxy.h>
 #include <utility>
+#include "Common/Symbol.h"
 
 namespace TinyCobalt::Common {
     using JSON = nlohmann::json;
@@ -33,6 +34,8 @@ namespace TinyCobalt::Common {
         { fromJSON<T>(std::declval<JSON>()) } -> std::same_as<T>;
     };
 
+    inline void to_json(JSON &json, const Symbol &symbol) { json = std::string(symbol.view()); }
+
     using nlohmann::operator""_json;
     using nlohmann::operator""_json_pointer;
 
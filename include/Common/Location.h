@@ -0,0 +1,84 @@
+//
+// Created by Renatus Madrigal on 01/18/2025
+//
+
+#ifndef TINY_COBALT_INCLUDE_COMMON_LOCATION_H_
+#define TINY_COBALT_INCLUDE_COMMON_LOCATION_H_
+
+#include <cstdint>
+#include <iostream>
+
+namespace TinyCobalt::Common {
+    /// A point in the offset space of a SourceManager. Line and column are computed only when decoded.
+    using SourceOffset = std::uint32_t;
+
+    /// A half-open range [begin, end) of source offsets.
+    class Location {
+    public:
+        /// Type for the character counts reported by the scanner.
+        typedef int counter_type;
+
+        /// Construct a location from \a b to \a e.
+        Location(SourceOffset b, SourceOffset e) : begin(b), end(e) {}
+
+        /// Construct a 0-width location at \a p.
+        explicit Location(SourceOffset p = 0) : begin(p), end(p) {}
+
+        /// Initialization.
+        void initialize(SourceOffset p = 0) { begin = end = p; }
+
+        /** \name Manipulators used by the scanner
+         ** \{ */
+        /// Reset initial location to final location.
+        void step() { begin = end; }
+
+        /// Extend the current location by COUNT characters. Line breaks are counted like any other character.
+        void columns(counter_type count = 1) { end += count; }
+        /** \} */
+
+        SourceOffset length() const { return end - begin; }
+
+        /// Beginning of the located region.
+        SourceOffset begin;
+        /// End of the located region, exclusive.
+        SourceOffset end;
+    };
+
+    /// Join two locations, in place.
+    inline Location &operator+=(Location &res, const Location &end) {
+        res.end = end.end;
+        return res;
+    }
+
+    /// Join two locations.
+    inline Location operator+(Location res, const Location &end) { return res += end; }
+
+    /// Add \a width characters to the end position, in place.
+    inline Location &operator+=(Location &res, Location::counter_type width) {
+        res.columns(width);
+        return res;
+    }
+
+    /// Add \a width characters to the end position.
+    inline Location operator+(Location res, Location::counter_type width) { return res += width; }
+
+    inline bool operator==(const Location &lhs, const Location &rhs) {
+        return lhs.begin == rhs.begin && lhs.end == rhs.end;
+    }
+
+    /** \brief Intercept output stream redirection.
+     ** \param ostr the destination output stream
+     ** \param loc a reference to the location to redirect
+     **
+     ** Only the raw offsets are printed. Use SourceManager::format for file, line and column.
+     */
+    template<typename Char>
+    std::basic_ostream<Char> &operator<<(std::basic_ostream<Char> &ostr, const Location &loc) {
+        ostr << '@' << loc.begin;
+        if (loc.begin < loc.end)
+            ostr << '-' << loc.end;
+        return ostr;
+    }
+} // namespace TinyCobalt::Common
+
+#endif // TINY_COBALT_INCLUDE_COMMON_LOCATION_H_
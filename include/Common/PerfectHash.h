@@ -0,0 +1,72 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_COMMON_PERFECTHASH_H_
+#define TINY_COBALT_INCLUDE_COMMON_PERFECTHASH_H_
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace TinyCobalt::Common {
+
+    /**
+     * A perfect hash over a fixed set of strings, built at compile time. The constructor searches for a seed under
+     * which every key lands in its own slot of a power-of-two table, so a lookup is one hash, one mask and at most one
+     * string comparison.
+     */
+    template<std::size_t N>
+    class PerfectHash {
+    public:
+        static constexpr std::size_t kTableSize = std::bit_ceil(N * 2);
+
+        consteval explicit PerfectHash(const std::array<std::string_view, N> &keys) : keys_(keys) {
+            for (seed_ = 1;; ++seed_) {
+                slots_.fill(kEmpty);
+                bool collided = false;
+                for (std::size_t i = 0; i < N && !collided; ++i) {
+                    auto &slot = slots_[hash(keys[i], seed_) & (kTableSize - 1)];
+                    collided = slot != kEmpty;
+                    slot = static_cast<std::uint8_t>(i);
+                }
+                if (!collided)
+                    break;
+            }
+        }
+
+        // Index of name in the key array, or nullopt if name is not a key.
+        constexpr std::optional<std::size_t> find(std::string_view name) const {
+            auto index = slots_[hash(name, seed_) & (kTableSize - 1)];
+            if (index == kEmpty || keys_[index] != name)
+                return std::nullopt;
+            return index;
+        }
+
+        constexpr bool contains(std::string_view name) const { return find(name).has_value(); }
+
+        constexpr const std::array<std::string_view, N> &keys() const { return keys_; }
+
+    private:
+        static_assert(N < 0xFF, "PerfectHash supports at most 254 keys");
+        static constexpr std::uint8_t kEmpty = 0xFF;
+
+        // FNV-1a seeded through the offset basis.
+        static constexpr std::uint32_t hash(std::string_view name, std::uint32_t seed) {
+            std::uint32_t h = 2166136261u ^ seed;
+            for (char c: name)
+                h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+            return h ^ (h >> 15);
+        }
+
+        std::array<std::string_view, N> keys_;
+        std::array<std::uint8_t, kTableSize> slots_{};
+        std::uint32_t seed_ = 0;
+    };
+
+} // namespace TinyCobalt::Common
+
+#endif // TINY_COBALT_INCLUDE_COMMON_PERFECTHASH_H_
@@ -0,0 +1,142 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_COMMON_SYMBOL_H_
+#define TINY_COBALT_INCLUDE_COMMON_SYMBOL_H_
+
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include "Common/Arena.h"
+
+namespace TinyCobalt::Common {
+
+    class StringPool;
+
+    /**
+     * A handle to an interned string. Symbols from the same pool are equal iff they point to the same entry, so the
+     * common case of comparing names is a pointer comparison. Symbols from different pools are still compared by
+     * their content, with the precomputed hash rejecting almost all mismatches.
+     */
+    class Symbol {
+    public:
+        struct Entry {
+            std::string_view text;
+            std::size_t hash;
+        };
+
+        Symbol() : entry_(&kEmptyEntry) {}
+
+        // Implicit conversions intern the text into the process-wide pool. Hot paths should intern through their own
+        // StringPool instead.
+        Symbol(std::string_view text);
+        Symbol(const std::string &text) : Symbol(std::string_view(text)) {}
+        Symbol(const char *text) : Symbol(std::string_view(text)) {}
+
+        std::string_view view() const { return entry_->text; }
+        std::string str() const { return std::string(entry_->text); }
+        const char *data() const { return entry_->text.data(); }
+        std::size_t size() const { return entry_->text.size(); }
+        bool empty() const { return entry_->text.empty(); }
+        std::size_t hash() const { return entry_->hash; }
+
+        friend bool operator==(const Symbol &lhs, const Symbol &rhs) {
+            return lhs.entry_ == rhs.entry_ || (lhs.entry_->hash == rhs.entry_->hash && lhs.view() == rhs.view());
+        }
+        friend bool operator==(const Symbol &lhs, std::string_view rhs) { return lhs.view() == rhs; }
+        friend bool operator==(const Symbol &lhs, const std::string &rhs) { return lhs.view() == rhs; }
+        friend bool operator==(const Symbol &lhs, const char *rhs) { return lhs.view() == rhs; }
+
+        // Symbols are ordered by hash first. The order is stable across pools but is not lexicographic.
+        friend std::strong_ordering operator<=>(const Symbol &lhs, const Symbol &rhs) {
+            if (lhs.entry_ == rhs.entry_)
+                return std::strong_ordering::equal;
+            if (auto cmp = lhs.entry_->hash <=> rhs.entry_->hash; cmp != 0)
+                return cmp;
+            return lhs.view() <=> rhs.view();
+        }
+
+        friend std::ostream &operator<<(std::ostream &os, const Symbol &symbol) { return os << symbol.view(); }
+
+    private:
+        friend class StringPool;
+        explicit Symbol(const Entry *entry) : entry_(entry) {}
+
+        static constexpr Entry kEmptyEntry{std::string_view(), 0};
+
+        const Entry *entry_;
+    };
+
+    /**
+     * An append-only string interner. Strings are copied once into an arena and never move, so the returned
+     * symbols stay valid for the lifetime of the pool. A pool is not thread-safe; use one per compilation.
+     */
+    class StringPool {
+    public:
+        StringPool() = default;
+        StringPool(const StringPool &) = delete;
+        StringPool &operator=(const StringPool &) = delete;
+
+        Symbol intern(std::string_view text) {
+            if (text.empty())
+                return Symbol();
+            auto hash = std::hash<std::string_view>{}(text);
+            if (auto it = entries_.find(Symbol::Entry{text, hash}); it != entries_.end())
+                return Symbol(&*it);
+            auto [it, _] = entries_.insert(Symbol::Entry{store(text), hash});
+            return Symbol(&*it);
+        }
+
+        Symbol intern(const char *text, std::size_t size) { return intern(std::string_view(text, size)); }
+
+        // Number of distinct non-empty strings in the pool.
+        std::size_t size() const { return entries_.size(); }
+
+        /**
+         * The process-wide pool backing implicit Symbol construction. Access is serialized by a mutex.
+         */
+        static Symbol internGlobal(std::string_view text) {
+            static StringPool pool;
+            static std::mutex mutex;
+            std::lock_guard lock(mutex);
+            return pool.intern(text);
+        }
+
+    private:
+        static constexpr std::size_t kChunkSize = 16 * 1024;
+
+        struct EntryHash {
+            std::size_t operator()(const Symbol::Entry &entry) const { return entry.hash; }
+        };
+        struct EntryEqual {
+            bool operator()(const Symbol::Entry &lhs, const Symbol::Entry &rhs) const { return lhs.text == rhs.text; }
+        };
+
+        std::string_view store(std::string_view text) {
+            auto *stored = static_cast<char *>(arena_.allocate(text.size(), 1));
+            std::memcpy(stored, text.data(), text.size());
+            return std::string_view(stored, text.size());
+        }
+
+        // Node-based set, so entry addresses are stable.
+        std::unordered_set<Symbol::Entry, EntryHash, EntryEqual> entries_;
+        Arena arena_{kChunkSize};
+    };
+
+    inline Symbol::Symbol(std::string_view text) : Symbol(StringPool::internGlobal(text)) {}
+
+} // namespace TinyCobalt::Common
+
+template<>
+struct std::hash<TinyCobalt::Common::Symbol> {
+    std::size_t operator()(const TinyCobalt::Common::Symbol &symbol) const noexcept { return symbol.hash(); }
+};
+
+#endif // TINY_COBALT_INCLUDE_COMMON_SYMBOL_H_
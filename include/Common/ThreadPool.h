@@ -0,0 +1,90 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_COMMON_THREADPOOL_H_
+#define TINY_COBALT_INCLUDE_COMMON_THREADPOOL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace TinyCobalt::Common {
+
+    /**
+     * A fixed-size pool of worker threads consuming a FIFO task queue. Destroying the pool finishes the queued tasks
+     * and joins the workers.
+     */
+    class ThreadPool {
+    public:
+        explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency()) {
+            threads = std::max<std::size_t>(threads, 1);
+            workers_.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i)
+                workers_.emplace_back([this] { work(); });
+        }
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard lock(mutex_);
+                stopping_ = true;
+            }
+            ready_.notify_all();
+            // jthread joins on destruction.
+        }
+
+        // Run task on a worker. Exceptions thrown by the task are rethrown from the returned future.
+        template<typename F>
+        auto submit(F &&task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+            // std::function needs a copyable target, so the packaged task is shared.
+            auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+            auto future = packaged->get_future();
+            {
+                std::lock_guard lock(mutex_);
+                tasks_.emplace([packaged] { (*packaged)(); });
+            }
+            ready_.notify_one();
+            return future;
+        }
+
+        std::size_t size() const { return workers_.size(); }
+
+    private:
+        void work() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock(mutex_);
+                    ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                    if (tasks_.empty())
+                        return;
+                    task = std::move(tasks_.front());
+                    tasks_.pop();
+                }
+                task();
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::queue<std::function<void()>> tasks_;
+        bool stopping_ = false;
+        // Declared last so that the workers are joined before the queue is destroyed.
+        std::vector<std::jthread> workers_;
+    };
+
+} // namespace TinyCobalt::Common
+
+#endif // TINY_COBALT_INCLUDE_COMMON_THREADPOOL_H_
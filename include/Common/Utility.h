@@ -5,12 +5,14 @@
 #ifndef TINY_COBALT_INCLUDE_COMMON_UTILITY_H_
 #define TINY_COBALT_INCLUDE_COMMON_UTILITY_H_
 
+#include <algorithm>
 #include <concepts>
 #include <cstddef>
 #include <proxy.h>
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
 #include <variant>
 #include "Common/Concept.h"
@@ -359,18 +361,101 @@ namespace TinyCobalt {
             if constexpr (std::is_same_v<typename M::Result, void>) {
                 (try_invoke_void<std::tuple_element_t<Indices, PackArgs>>(m, std::forward<P>(ptr)), ...);
             } else {
-                typename M::Result result;
+                // Value-initialized, so that a node no candidate matches gives a well-defined result.
+                typename M::Result result{};
                 (try_invoke<std::tuple_element_t<Indices, PackArgs>>(&result, m, std::forward<P>(ptr)), ...);
                 return result;
             }
         }
+
+        // A candidate pointing to a type with a static kKind tag, e.g. an AST node.
+        template<typename Arg>
+        concept KindTagged = requires { Arg::element_type::kKind; };
+
+        template<typename Arg>
+        inline constexpr auto kKindIndex = static_cast<std::size_t>(Arg::element_type::kKind);
+
+        template<typename Args, typename P>
+        struct KindDispatch : std::false_type {};
+
+        template<typename... Args, typename P>
+            requires(sizeof...(Args) > 0)
+        struct KindDispatch<std::tuple<Args...>, P> {
+            static constexpr bool value =
+                    (KindTagged<Args> && ...) && requires(P ptr) { static_cast<std::size_t>(ptr->kind()); };
+            // Kinds past the last candidate have nothing to call, so the table stops there.
+            static constexpr std::size_t size = [] {
+                if constexpr ((KindTagged<Args> && ...))
+                    return std::max({kKindIndex<Args>...}) + 1;
+                else
+                    return std::size_t{0};
+            }();
+        };
+
+        // Invoke the candidate for Arg if it has the given kind and ptr holds an Arg. Other types may report the same
+        // kind, e.g. a node derived from Arg or a view of a flattened tree, so the held type is still checked once.
+        template<typename Arg, std::size_t Kind, typename Result, typename O, typename T>
+        bool invoke_kind(Result *res, O &&f, T &&op) {
+            if constexpr (kKindIndex<Arg> != Kind) {
+                return false;
+            } else {
+                if (proxy_typeid(op) != typeid(Arg))
+                    return false;
+                if constexpr (std::is_void_v<Result>)
+                    f(proxy_cast<Arg>(op));
+                else
+                    *res = f(proxy_cast<Arg>(op));
+                return true;
+            }
+        }
+
+        // The entry of the jump table for one kind. It only contains the candidates of that kind and stops at the
+        // first one that matches.
+        template<typename M, typename P, std::size_t Kind, std::size_t... Indices>
+        typename M::Result visitKindImpl(const M &m, P &ptr, std::index_sequence<Indices...>) {
+            using PackArgs = typename M::CandidateArgs;
+            if constexpr (std::is_void_v<typename M::Result>) {
+                void *none = nullptr;
+                (invoke_kind<std::tuple_element_t<Indices, PackArgs>, Kind>(none, m, ptr) || ...);
+            } else {
+                typename M::Result result{};
+                (invoke_kind<std::tuple_element_t<Indices, PackArgs>, Kind>(&result, m, ptr) || ...);
+                return result;
+            }
+        }
+
+        template<typename M, typename P, std::size_t Kind>
+        typename M::Result visitKind(const M &m, P &ptr) {
+            return visitKindImpl<M, P, Kind>(m, ptr,
+                                             std::make_index_sequence<std::tuple_size_v<typename M::CandidateArgs>>{});
+        }
+
+        template<typename M, typename P, std::size_t... Kinds>
+        typename M::Result visitByKind(const M &m, P &ptr, std::index_sequence<Kinds...>) {
+            using Entry = typename M::Result (*)(const M &, P &);
+            static constexpr Entry kTable[] = {&visitKind<M, P, Kinds>...};
+            auto kind = static_cast<std::size_t>(ptr->kind());
+            if (kind >= sizeof...(Kinds))
+                return typename M::Result();
+            return kTable[kind](m, ptr);
+        }
     } // namespace detail
 
+    /**
+     * Invoke the candidate of m that takes the type held by ptr. If every candidate points to a type with a kKind
+     * tag and the proxy reports kind(), the candidate is found through a table indexed by the kind. Otherwise each
+     * candidate is tried in turn by comparing types.
+     */
     // TODO: keep const qualifier
     template<typename M, RttiAwareProxy P>
     typename M::Result visit(const M &m, P &&ptr) {
-        constexpr auto size = std::tuple_size_v<typename M::CandidateArgs>;
-        return detail::visitImpl(std::move(m), ptr, std::make_index_sequence<size>{});
+        using Dispatch = detail::KindDispatch<typename M::CandidateArgs, std::remove_cvref_t<P>>;
+        if constexpr (Dispatch::value) {
+            return detail::visitByKind(m, ptr, std::make_index_sequence<Dispatch::size>{});
+        } else {
+            constexpr auto size = std::tuple_size_v<typename M::CandidateArgs>;
+            return detail::visitImpl(std::move(m), ptr, std::make_index_sequence<size>{});
+        }
     }
 
     template<typename... Fs>
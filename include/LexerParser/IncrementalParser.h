@@ -0,0 +1,63 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_LEXERPARSER_INCREMENTALPARSER_H_
+#define TINY_COBALT_INCLUDE_LEXERPARSER_INCREMENTALPARSER_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "AST/AST.h"
+#include "LexerParser/Parser.h"
+
+namespace TinyCobalt::LexerParser {
+    // Replace length bytes at offset with text.
+    struct TextEdit {
+        std::size_t offset;
+        std::size_t length;
+        std::string text;
+    };
+
+    /**
+     * Keeps a source text and its tree in sync under edits. An edit re-lexes and re-parses only the top-level
+     * statements it touches; the other statements of the previous root are reused as they are. If the touched region
+     * does not parse on its own, it is widened by one statement on each side until it does, up to the whole file.
+     *
+     * Node locations are offsets into source(). Nodes of reused statements keep the offsets of the text they were
+     * parsed from, so after an edit only the statements before it have exact locations.
+     */
+    class IncrementalParser {
+    public:
+        IncrementalParser();
+
+        // Parse the whole source. Return an error code like Parser::parse(). An empty source gives an empty root.
+        int parse(std::string source);
+
+        /**
+         * Apply the edit to the source and update the tree. On success the result is equal to a full parse of the new
+         * source. If the new source does not parse, result() is null until a later edit makes it valid again.
+         */
+        int applyEdit(const TextEdit &edit);
+
+        AST::ASTRootPtr result() const { return root_; }
+        const std::string &source() const { return source_; }
+
+    private:
+        struct Range {
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        // Parse source_[begin, end) as a sequence of top-level statements.
+        int parseRegion(std::size_t begin, std::size_t end, AST::ASTRootPtr &fragment, std::vector<Range> &ranges);
+
+        YaccDriver driver_;
+        std::string source_;
+        AST::ASTRootPtr root_;
+        // Byte range of each child of root_ in source_.
+        std::vector<Range> ranges_;
+    };
+} // namespace TinyCobalt::LexerParser
+
+#endif // TINY_COBALT_INCLUDE_LEXERPARSER_INCREMENTALPARSER_H_
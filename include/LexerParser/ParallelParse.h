@@ -0,0 +1,39 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_LEXERPARSER_PARALLELPARSE_H_
+#define TINY_COBALT_INCLUDE_LEXERPARSER_PARALLELPARSE_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AST/AST.h"
+#include "LexerParser/Parser.h"
+#include "LexerParser/SourceManager.h"
+
+namespace TinyCobalt::LexerParser {
+    struct ParseResult {
+        std::string file;
+        // Null if the file could not be read or parsed.
+        AST::ASTRootPtr root;
+        // The error code of the parser, or -1 if the file could not be read.
+        int error = 0;
+        std::string message;
+        // All syntax errors of the file.
+        std::vector<Diagnostic> diagnostics;
+    };
+
+    /**
+     * Parse the given files concurrently, one YaccDriver per file. The results are in the order of files regardless
+     * of which file finishes first. jobs = 0 uses one worker per hardware thread.
+     */
+    std::vector<ParseResult> parseFiles(const std::vector<std::string> &files, std::size_t jobs = 0);
+
+    // Same as above, with all files registered in one SourceManager that decodes the locations of every result.
+    std::vector<ParseResult> parseFiles(const std::vector<std::string> &files, std::shared_ptr<SourceManager> sources,
+                                        std::size_t jobs = 0);
+} // namespace TinyCobalt::LexerParser
+
+#endif // TINY_COBALT_INCLUDE_LEXERPARSER_PARALLELPARSE_H_
@@ -5,12 +5,38 @@
 #ifndef TINY_COBALT_INCLUDE_LEXERPARSER_PARSER_H_
 #define TINY_COBALT_INCLUDE_LEXERPARSER_PARSER_H_
 
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 #include "AST/AST.h"
+#include "Common/Arena.h"
+#include "Common/Symbol.h"
 #include "LexerParser/Location.h"
+#include "LexerParser/SourceBuffer.h"
+#include "LexerParser/SourceManager.h"
 
 namespace TinyCobalt::LexerParser {
+    // The scanner backends. Both produce the same token stream.
+    enum class LexerKind {
+        // The flex generated scanner.
+        Flex,
+        // The hand-written scanner in DirectLexer.cpp. It works on the whole input in memory.
+        Direct,
+    };
+
+    // A syntax error reported by the parser or the scanner.
+    struct Diagnostic {
+        Location location;
+        std::string message;
+    };
+
     // TODO: use concept to restrict Driver type.
     // We use template wrapper to allow the parser to be used with different driver classes.
     template<typename Driver>
@@ -25,17 +51,63 @@ namespace TinyCobalt::LexerParser {
 
         // Return an error code because bison uses it.
         int parse() { return driver->parse(); }
+        // Scan the input without parsing and return the number of tokens, end of file excluded.
+        std::size_t lex() { return driver->lex(); }
 
         BaseParser<Driver> &switchInput(std::istream *is) {
             driver->switchInput(is);
             return *this;
         }
+        // Scan a caller-owned buffer, which must outlive the calls to parse(). The SourceManager gets a copy of it, so
+        // locations can be decoded after the buffer is gone; only a parse without a SourceManager scans it in place.
+        BaseParser<Driver> &switchInput(std::span<const char> source) {
+            driver->switchInput(source);
+            return *this;
+        }
+        // Map the file into memory at each parse and scan it in place. parse() throws std::system_error if it cannot.
+        BaseParser<Driver> &switchInputFile(const std::string &path) {
+            driver->switchInputFile(path);
+            return *this;
+        }
         BaseParser<Driver> &switchOutput(std::ostream *os) {
             driver->switchOutput(os);
             return *this;
         }
+#ifdef TINYCOBALT_ENABLE_TRACE
+        // Print parser and flex scanner traces to stderr. Only debug builds have traces.
+        BaseParser<Driver> &setTrace(bool parsing, bool scanning) {
+            driver->setTrace(parsing, scanning);
+            return *this;
+        }
+#endif
+        BaseParser<Driver> &switchLexer(LexerKind kind) {
+            driver->lexerKind = kind;
+            return *this;
+        }
+        // Hand each top-level statement to sink as soon as it is parsed instead of collecting it into result().
+        BaseParser<Driver> &setTopLevelSink(typename Driver::TopLevelSink sink) {
+            driver->topLevelSink = std::move(sink);
+            return *this;
+        }
+
+        // Cache token streams in dir, so that parsing an unchanged text again skips the scanner. Empty disables it.
+        BaseParser<Driver> &setTokenCacheDir(std::string dir) {
+            driver->tokenCacheDir = std::move(dir);
+            return *this;
+        }
+
+        // Share one offset space with other parsers. Null opts out of registering the input at all.
+        BaseParser<Driver> &setSourceManager(std::shared_ptr<SourceManager> sources) {
+            driver->sources = std::move(sources);
+            driver->sharedSources = true;
+            return *this;
+        }
 
         AST::ASTRootPtr result() { return driver->result; }
+        // Syntax errors of the last parse, in order.
+        const std::vector<Diagnostic> &diagnostics() { return driver->diagnostics; }
+        // Decodes the locations of the result of the last parse.
+        std::shared_ptr<SourceManager> sources() { return driver->sources; }
 
     private:
         Driver *driver;
@@ -45,47 +117,160 @@ namespace TinyCobalt::LexerParser {
 
     // Forward declaration of YaccLexer.
     class YaccLexer;
+    class DirectLexer;
+    class TokenCache;
 
     class YaccDriver {
     public:
         YaccDriver();
         YaccDriver(std::istream *is, std::ostream *os);
 
-        void switchInput(std::istream *is) { this->is = is; }
+        void switchInput(std::istream *is) {
+            this->is = is;
+            this->span.reset();
+            this->mapFile = false;
+        }
+        void switchInput(std::span<const char> source) {
+            this->span = source;
+            this->is = nullptr;
+            this->mapFile = false;
+        }
+        void switchInputFile(const std::string &path) {
+            this->file = path;
+            this->is = nullptr;
+            this->span.reset();
+            this->mapFile = true;
+        }
         void switchOutput(std::ostream *os) { this->os = os; }
+#ifdef TINYCOBALT_ENABLE_TRACE
+        void setTrace(bool parsing, bool scanning) {
+            this->trace_parsing = parsing;
+            this->trace_scanning = scanning;
+        }
+#endif
 
         AST::ASTRootPtr result;
 
-        // Start parsing.
+        /**
+         * Start parsing. The parser recovers from syntax errors at statement and block boundaries, so one call
+         * reports every error to diagnostics. Return non-zero if there was any. The result then holds the statements
+         * that did parse, with an empty statement in place of each skipped one, or is null if recovery failed.
+         */
         int parse();
 
-        YaccLexer *lexer;
+        /**
+         * Scan the whole input without parsing and return the number of tokens, end of file excluded.
+         * @throw yy::parser::syntax_error on the first invalid token.
+         */
+        std::size_t lex();
+
+        std::vector<Diagnostic> diagnostics;
+        void report(const Location &loc, std::string message) { diagnostics.push_back({loc, std::move(message)}); }
+
+        YaccLexer *lexer = nullptr;
+        DirectLexer *directLexer = nullptr;
+        LexerKind lexerKind = LexerKind::Flex;
+        // Replays or records the tokens of the input when tokenCacheDir is set.
+        TokenCache *tokenCache = nullptr;
+        std::string tokenCacheDir;
+
+        // State of nextToken for splitting a ">>" that closes two template argument lists.
+        std::size_t templateDepth = 0;
+        int lastTokenKind = 0;
+        std::optional<Location> pendingGreater;
 
         // Handling the scanner.
         void scan_begin();
         void scan_end();
         // The token's location used by the scanner.
         Location location;
+        // Location of the rule being reduced. allocNode attaches it to the nodes created by the rule.
+        Location reducing;
+
+        /**
+         * Each input is registered here before it is scanned, and locations are offsets into it. The manager keeps a
+         * copy of every input, so unless it was set by the caller, each parse starts with a fresh one; keep the
+         * previous one to decode the locations of a previous tree.
+         */
+        std::shared_ptr<SourceManager> sources = std::make_shared<SourceManager>();
+        bool sharedSources = false;
+        // Without a SourceManager the input is not registered, and offsets start here instead. Use this to parse a
+        // fragment of a text with offsets relative to the whole text.
+        SourceOffset start = 0;
+        // Format a location for messages.
+        std::string describe(const Location &loc) const;
+        // Locations of the top-level statements of the last parse, in order.
+        std::vector<Location> topLevelLocations;
+
+        // Names and literals of the compilation. The tree produced by parse() keeps the pool alive.
+        std::shared_ptr<Common::StringPool> symbols = std::make_shared<Common::StringPool>();
+        Common::Symbol intern(const char *text, std::size_t size) { return symbols->intern(text, size); }
+
+        /**
+         * Receiver of top-level statements in streaming mode. When set, the root produced by parse() has no children.
+         * Streamed nodes are allocated on the heap, so each statement is freed as soon as the sink drops it. Each of
+         * them keeps symbols alive, so the sink may keep a statement after the parser is gone.
+         */
+        using TopLevelSink = std::function<void(AST::StmtNodePtr)>;
+        TopLevelSink topLevelSink;
+        void pushTopLevel(std::vector<AST::StmtNodePtr> &stmts, AST::StmtNodePtr stmt, const Location &loc) {
+            topLevelLocations.push_back(loc);
+            if (topLevelSink)
+                topLevelSink(std::move(stmt));
+            else
+                stmts.emplace_back(std::move(stmt));
+        }
+
+        // Nodes of the compilation are allocated from this arena. Every node shares ownership of the arena, which
+        // keeps symbols alive in turn, so a node may outlive its root. Each call to parse() starts a new arena.
+        std::shared_ptr<Common::Arena> arena = Common::makeArena(symbols);
 
         // For customize allocation
         template<typename T, typename... Args>
         auto allocNode(Args &&...args) {
-            return std::make_shared<T>(std::forward<Args>(args)...);
+            std::shared_ptr<T> node;
+            // The root owns the arena, so it cannot live inside it. Streamed statements are released one by one.
+            if (std::is_same_v<T, AST::ASTRootNode>)
+                node = std::make_shared<T>(std::forward<Args>(args)...);
+            else if (topLevelSink)
+                node = std::allocate_shared<T>(Common::OwningAllocator<T>(symbols), std::forward<Args>(args)...);
+            else
+                node = std::allocate_shared<T>(Common::SharedArenaAllocator<T>(arena), std::forward<Args>(args)...);
+            node->location = reducing;
+            return node;
         }
 
     private:
         // The name of the file being parsed.
         std::string file;
-        std::istream *is;
-        std::ostream *os;
+        std::istream *is = nullptr;
+        std::ostream *os = nullptr;
+        // Caller-owned input. When set, the scanner reads from it instead of is.
+        std::optional<std::span<const char>> span;
+        // Whether the input is the file, mapped again by every parse.
+        bool mapFile = false;
+        // The text being scanned when it is not registered with sources.
+        std::optional<SourceBuffer> buffer;
+        // The text of the next parse. The input itself is kept, so that it can be parsed again.
+        SourceBuffer readInput() const;
         // Whether to generate parser debug traces.
-        bool trace_parsing;
+        bool trace_parsing = false;
         // Whether to generate scanner debug traces.
-        bool trace_scanning;
+        bool trace_scanning = false;
+    };
+
+    // A driver using the hand-written scanner.
+    class DirectYaccDriver : public YaccDriver {
+    public:
+        template<typename... Args>
+        DirectYaccDriver(Args &&...args) : YaccDriver(std::forward<Args>(args)...) {
+            this->lexerKind = LexerKind::Direct;
+        }
     };
 
     // Using YaccDriver by default.
     using Parser = BaseParser<YaccDriver>;
+    using DirectParser = BaseParser<DirectYaccDriver>;
 } // namespace TinyCobalt::LexerParser
 
 #endif // TINY_COBALT_INCLUDE_LEXERPARSER_PARSER_H_
\ No newline at end of file
@@ -0,0 +1,64 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_LEXERPARSER_SOURCEBUFFER_H_
+#define TINY_COBALT_INCLUDE_LEXERPARSER_SOURCEBUFFER_H_
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TinyCobalt::LexerParser {
+
+    /**
+     * A read-only, contiguous view of a whole source file. The buffer either maps a file into memory or borrows a
+     * span owned by the caller, so the lexer can scan the text directly instead of pulling it through std::istream.
+     */
+    class SourceBuffer {
+    public:
+        SourceBuffer() = default;
+
+        /**
+         * Borrow a caller-owned span. The span must outlive the buffer and every parse that uses it.
+         */
+        explicit SourceBuffer(std::span<const char> data) : data_(data) {}
+
+        /**
+         * Take ownership of text read from elsewhere, e.g. a stream.
+         */
+        explicit SourceBuffer(std::vector<char> text) : owned_(std::move(text)) { data_ = owned_; }
+
+        SourceBuffer(const SourceBuffer &) = delete;
+        SourceBuffer &operator=(const SourceBuffer &) = delete;
+        SourceBuffer(SourceBuffer &&other) noexcept;
+        SourceBuffer &operator=(SourceBuffer &&other) noexcept;
+        ~SourceBuffer();
+
+        /**
+         * Map the file at the given path into memory.
+         * @throw std::system_error if the file cannot be opened or mapped.
+         */
+        static SourceBuffer map(const std::string &path);
+
+        std::span<const char> data() const { return data_; }
+        const char *begin() const { return data_.data(); }
+        const char *end() const { return data_.data() + data_.size(); }
+        std::size_t size() const { return data_.size(); }
+        bool empty() const { return data_.empty(); }
+
+    private:
+        void release() noexcept;
+
+        std::span<const char> data_;
+        // Whether data_ points to a region created by mmap and must be unmapped.
+        bool mapped_ = false;
+        // Storage for text not backed by a mapping.
+        std::vector<char> owned_;
+    };
+
+} // namespace TinyCobalt::LexerParser
+
+#endif // TINY_COBALT_INCLUDE_LEXERPARSER_SOURCEBUFFER_H_
@@ -0,0 +1,83 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_LEXERPARSER_SOURCEMANAGER_H_
+#define TINY_COBALT_INCLUDE_LEXERPARSER_SOURCEMANAGER_H_
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "LexerParser/Location.h"
+#include "LexerParser/SourceBuffer.h"
+
+namespace TinyCobalt::LexerParser {
+
+    /**
+     * Maps every source file of a compilation into one 32-bit offset space, so that a source position is a single
+     * SourceOffset. Files are laid out one after another with a gap of one offset, which keeps the end of a file
+     * distinct from the beginning of the next one. Line tables are built on the first decode of a file.
+     *
+     * All member functions are thread-safe.
+     */
+    class SourceManager {
+    public:
+        struct File {
+            std::string name;
+            SourceBuffer buffer;
+            // Offset of the first character of the file.
+            SourceOffset base;
+
+            std::span<const char> text() const { return buffer.data(); }
+            // Offset one past the last character of the file.
+            SourceOffset end() const { return base + static_cast<SourceOffset>(buffer.size()); }
+        };
+
+        // A location decoded for humans. Lines and columns are 1-based, columns count bytes.
+        struct Decoded {
+            std::string_view file;
+            std::uint32_t line;
+            std::uint32_t column;
+        };
+
+        SourceManager() = default;
+        SourceManager(const SourceManager &) = delete;
+        SourceManager &operator=(const SourceManager &) = delete;
+
+        /**
+         * Register a file and return its entry. The entry stays valid for the lifetime of the manager.
+         * @throw std::length_error if the offset space is exhausted.
+         */
+        const File &addFile(std::string name, SourceBuffer buffer);
+
+        // The file containing the offset, or nullptr. The end offset of a file belongs to the file.
+        const File *findFile(SourceOffset offset) const;
+
+        Decoded decode(SourceOffset offset) const;
+
+        // Format as file:line.column, with the end column or line appended when the location spans characters.
+        std::string format(const Location &loc) const;
+
+    private:
+        struct Entry : File {
+            mutable std::once_flag lines_once;
+            // Offsets of the first character of each line, relative to base.
+            mutable std::vector<std::uint32_t> line_starts;
+        };
+
+        const std::vector<std::uint32_t> &lineStarts(const Entry &entry) const;
+
+        mutable std::shared_mutex mutex_;
+        // Deque for stable addresses.
+        std::deque<Entry> files_;
+        SourceOffset next_ = 0;
+    };
+
+} // namespace TinyCobalt::LexerParser
+
+#endif // TINY_COBALT_INCLUDE_LEXERPARSER_SOURCEMANAGER_H_
@@ -12,6 +12,7 @@
 #include "AST/StmtNode.h"
 #include "AST/TypeNode.h"
 #include "Common/Assert.h"
+#include "Common/Symbol.h"
 #include "Semantic/Scope.h"
 
 namespace TinyCobalt::Semantic {
@@ -29,10 +30,10 @@ namespace TinyCobalt::Semantic {
         AST::VisitorState afterSubtreeImpl(AST::ASTNodePtr node);
 
     private:
-        using FuncScope = Scope<std::string, AST::FuncDefPtr>;
-        using VariableScope = Scope<std::string, AST::VariableDefPtr>;
-        using AliasScope = Scope<std::string, AST::AliasDefPtr>;
-        using StructScope = Scope<std::string, AST::StructDefPtr>;
+        using FuncScope = Scope<Common::Symbol, AST::FuncDefPtr>;
+        using VariableScope = Scope<Common::Symbol, AST::VariableDefPtr>;
+        using AliasScope = Scope<Common::Symbol, AST::AliasDefPtr>;
+        using StructScope = Scope<Common::Symbol, AST::StructDefPtr>;
 
         void pushScope(const std::string &name = kDefaultScopeName);
 
@@ -40,7 +41,7 @@ namespace TinyCobalt::Semantic {
 
         using TypeDefPtr = AST::SimpleTypeNode::TypeDefPtr;
 
-        TypeDefPtr findType(const std::string &name);
+        TypeDefPtr findType(const Common::Symbol &name);
 
         std::unique_ptr<FuncScope> current_func_ = nullptr;
         std::unique_ptr<VariableScope> current_variable_ = nullptr;
@@ -8,14 +8,23 @@
 #include "AST/ASTVisitor.h"
 #include "AST/ExprNode.h"
 #include "Common/Assert.h"
+#include "Semantic/TypeContext.h"
 
 namespace TinyCobalt::Semantic {
     class TypeAnalyzer : public AST::BaseASTVisitorMiddleware<TypeAnalyzer> {
+    public:
+        // Store the type of each expression node in its exprType() slot, after its operands are resolved.
         AST::VisitorState afterSubtreeImpl(AST::ASTNodePtr node);
 
+        // Resolved types are canonical nodes of this context.
+        TypeContext &types() { return types_; }
+
+    private:
 #define REG_ANALYZE_NODE(Name, ...) AST::VisitorState analyzeType(AST::Name##Ptr node);
         TINY_COBALT_AST_EXPR_NODES(REG_ANALYZE_NODE)
 #undef REG_ANALYZE_NODE
+
+        TypeContext types_;
     };
 
     TINY_COBALT_CONCEPT_ASSERT(AST::ASTVisitorMiddlewareConcept, TypeAnalyzer);
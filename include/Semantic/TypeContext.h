@@ -0,0 +1,90 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_INCLUDE_SEMANTIC_TYPECONTEXT_H_
+#define TINY_COBALT_INCLUDE_SEMANTIC_TYPECONTEXT_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "AST/ASTNodeDecl.h"
+#include "AST/TypeNode.h"
+#include "Common/Symbol.h"
+
+namespace TinyCobalt::Semantic {
+
+    /**
+     * Owns the canonical type nodes of a compilation. Types are hash-consed: structurally equal types are the same
+     * node, so type equality is a pointer comparison and a type like Pointer<char> is allocated once. Canonical simple
+     * types of the builtin names are the nodes of AST::BuiltInType.
+     *
+     * Types written in the tree are not canonical; intern() maps them to their canonical node. A context is not
+     * thread-safe; use one per compilation, like a StringPool.
+     */
+    class TypeContext {
+    public:
+        TypeContext();
+        TypeContext(const TypeContext &) = delete;
+        TypeContext &operator=(const TypeContext &) = delete;
+
+        // A builtin type, or a name that is not resolved to a declaration.
+        AST::SimpleTypePtr simple(std::string_view name);
+        /**
+         * A simple type resolved by DeclMatcher. Types declared by an alias or a struct are keyed by their declaration,
+         * so that declarations of the same name in different scopes are different types, and the canonical node
+         * keeps the declaration in its def.
+         */
+        AST::SimpleTypePtr simple(std::string_view name, const AST::SimpleTypeNode::TypeDefPtr &def);
+        // Parameter and return types may be non-canonical.
+        AST::FuncTypePtr func(const AST::TypeNodePtr &returnType, const std::vector<AST::TypeNodePtr> &paramTypes);
+        // Type arguments may be non-canonical. Constant arguments are compared by type and value.
+        AST::ComplexTypePtr complex(std::string_view name,
+                                    const std::vector<AST::ComplexTypeNode::TemplateArgType> &templateArgs);
+        AST::ComplexTypePtr pointer(const AST::TypeNodePtr &pointee);
+
+        // The canonical node of a type, or null for a null type.
+        AST::TypeNodePtr intern(const AST::TypeNodePtr &type);
+
+        // The pointee of a canonical Pointer type, or null if the type is not a pointer.
+        AST::TypeNodePtr pointee(const AST::TypeNodePtr &type) const;
+        // The element type of a canonical Pointer or Array type, or null if the type is neither.
+        AST::TypeNodePtr element(const AST::TypeNodePtr &type) const;
+
+        // Whether two canonical types are the same type.
+        static bool same(const AST::TypeNodePtr &lhs, const AST::TypeNodePtr &rhs) {
+            return lhs && rhs && lhs->thisPointer() == rhs->thisPointer();
+        }
+
+        // Number of canonical types.
+        std::size_t size() const { return simple_.size() + declared_.size() + func_.size() + complex_.size(); }
+
+    private:
+        // Identities of the name and the canonical children of a type.
+        using Key = std::vector<const void *>;
+        struct KeyHash {
+            std::size_t operator()(const Key &key) const;
+        };
+
+        AST::ConstExprPtr constant(const AST::ConstExprPtr &expr);
+        // The first type argument of a canonical complex type with the given canonical name.
+        AST::TypeNodePtr typeArgument(const AST::TypeNodePtr &type, const Common::Symbol &name) const;
+
+        // Names of canonical nodes point into this pool, so that they compare by address.
+        Common::StringPool names_;
+        std::unordered_map<const char *, AST::SimpleTypePtr> simple_;
+        // Keyed by the AliasDef or StructDef node.
+        std::unordered_map<const void *, AST::SimpleTypePtr> declared_;
+        std::unordered_map<Key, AST::FuncTypePtr, KeyHash> func_;
+        std::unordered_map<Key, AST::ComplexTypePtr, KeyHash> complex_;
+        // Constant template arguments, keyed by type and spelling.
+        std::unordered_map<std::string, AST::ConstExprPtr> constants_;
+        Common::Symbol pointer_;
+        Common::Symbol array_;
+    };
+
+} // namespace TinyCobalt::Semantic
+
+#endif // TINY_COBALT_INCLUDE_SEMANTIC_TYPECONTEXT_H_
@@ -3,14 +3,28 @@
 //
 
 #include "AST/ASTNode.h"
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include "AST/ASTNodeDecl.h"
 #include "AST/TypeNode.h"
 #include "Common/JSON.h"
 
 namespace TinyCobalt::AST {
 
+    namespace {
+        [[noreturn]] void childOutOfRange(std::string_view node, std::size_t index) {
+            throw std::out_of_range(std::string(node) + " node has no child " + std::to_string(index));
+        }
+    } // namespace
+
     // TypeNode
-    ASTNodeGen SimpleTypeNode::traverse() { co_return; }
+    std::size_t SimpleTypeNode::childCount() const { return 0; }
+
+    ASTNodePtr SimpleTypeNode::child(std::size_t index) const { childOutOfRange("SimpleType", index); }
 
     Common::JSON SimpleTypeNode::toJSON() const {
         Common::JSON json;
@@ -19,11 +33,14 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen FuncTypeNode::traverse() {
-        co_yield returnType;
-        for (auto &paramType: paramTypes) {
-            co_yield paramType;
-        }
+    std::size_t FuncTypeNode::childCount() const { return paramTypes.size() + 1; }
+
+    ASTNodePtr FuncTypeNode::child(std::size_t index) const {
+        if (index == 0)
+            return returnType;
+        if (index <= paramTypes.size())
+            return paramTypes[index - 1];
+        childOutOfRange("FuncType", index);
     }
 
     Common::JSON FuncTypeNode::toJSON() const {
@@ -42,10 +59,12 @@ namespace TinyCobalt::AST {
         ASTNodePtr operator()(const ConstExprPtr &expr) const { return expr; }
     };
 
-    ASTNodeGen ComplexTypeNode::traverse() {
-        for (auto &arg: templateArgs) {
-            co_yield std::visit(Visitor{}, arg);
-        }
+    std::size_t ComplexTypeNode::childCount() const { return templateArgs.size(); }
+
+    ASTNodePtr ComplexTypeNode::child(std::size_t index) const {
+        if (index >= templateArgs.size())
+            childOutOfRange("ComplexType", index);
+        return std::visit(Visitor{}, templateArgs[index]);
     }
 
     Common::JSON ComplexTypeNode::toJSON() const {
@@ -61,17 +80,107 @@ namespace TinyCobalt::AST {
 
     // ExprNode
 
-    ASTNodeGen ConstExprNode::traverse() { co_return; }
+    namespace {
+        std::uint64_t decodeInteger(std::string_view digits, int base) {
+            std::uint64_t res = 0;
+            auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), res, base);
+            if (ec == std::errc::result_out_of_range)
+                throw std::out_of_range("integer literal out of range: " + std::string(digits));
+            if (ec != std::errc() || ptr != digits.data() + digits.size() || digits.empty())
+                throw std::invalid_argument("invalid integer literal: " + std::string(digits));
+            return res;
+        }
+
+        std::string encodeInteger(std::uint64_t value, int base) {
+            char buf[64];
+            auto res = std::to_chars(buf, buf + sizeof(buf), value, base);
+            return std::string(buf, res.ptr);
+        }
+    } // namespace
+
+    ConstExprNode::Value ConstExprNode::decode(std::string_view text, ConstExprType type) {
+        // Prefixed integers have a two-character prefix like 0x.
+        auto prefixed = [text](std::string_view prefix) {
+            if (!text.starts_with(prefix))
+                throw std::invalid_argument("invalid integer literal: " + std::string(text));
+            return text.substr(prefix.size());
+        };
+        switch (type) {
+            case ConstExprType::Int:
+                return decodeInteger(text, 10);
+            case ConstExprType::HexInt:
+                return decodeInteger(prefixed("0x"), 16);
+            case ConstExprType::OctInt:
+                return decodeInteger(prefixed("0o"), 8);
+            case ConstExprType::BinInt:
+                return decodeInteger(prefixed("0b"), 2);
+            case ConstExprType::Float: {
+                double res = 0;
+                auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), res);
+                if (ec == std::errc::result_out_of_range)
+                    throw std::out_of_range("float literal out of range: " + std::string(text));
+                if (ec != std::errc() || ptr != text.data() + text.size())
+                    throw std::invalid_argument("invalid float literal: " + std::string(text));
+                return res;
+            }
+            case ConstExprType::Char:
+                if (text.size() != 3 || text.front() != '\'' || text.back() != '\'')
+                    throw std::invalid_argument("invalid char literal: " + std::string(text));
+                return text[1];
+            case ConstExprType::Bool:
+                if (text != "true" && text != "false")
+                    throw std::invalid_argument("invalid bool literal: " + std::string(text));
+                return text == "true";
+            case ConstExprType::String:
+                return Common::Symbol(text);
+        }
+        throw std::invalid_argument("unknown literal type");
+    }
+
+    std::string ConstExprNode::text() const {
+        switch (type) {
+            case ConstExprType::Int:
+                return encodeInteger(std::get<std::uint64_t>(value), 10);
+            case ConstExprType::HexInt:
+                return "0x" + encodeInteger(std::get<std::uint64_t>(value), 16);
+            case ConstExprType::OctInt:
+                return "0o" + encodeInteger(std::get<std::uint64_t>(value), 8);
+            case ConstExprType::BinInt:
+                return "0b" + encodeInteger(std::get<std::uint64_t>(value), 2);
+            case ConstExprType::Float: {
+                char buf[64];
+                auto res = std::to_chars(buf, buf + sizeof(buf), std::get<double>(value));
+                std::string str(buf, res.ptr);
+                // Keep the spelling a float literal, e.g. 1.0 rather than 1.
+                if (str.find_first_of(".en") == std::string::npos)
+                    str += ".0";
+                return str;
+            }
+            case ConstExprType::Char:
+                return std::string{'\'', std::get<char>(value), '\''};
+            case ConstExprType::Bool:
+                return std::get<bool>(value) ? "true" : "false";
+            case ConstExprType::String:
+                return std::get<Common::Symbol>(value).str();
+        }
+        throw std::logic_error("ConstExprNode: unknown literal type");
+    }
+
+    std::size_t ConstExprNode::childCount() const { return 0; }
+
+    ASTNodePtr ConstExprNode::child(std::size_t index) const { childOutOfRange("ConstExpr", index); }
 
     Common::JSON ConstExprNode::toJSON() const {
         Common::JSON json;
         json["type"] = "ConstExpr";
-        json["value"] = value;
+        json["value"] = text();
         json["expr_type"] = magic_enum::enum_name(type);
         return json;
     }
 
-    ASTNodeGen VariableNode::traverse() { co_return; }
+    std::size_t VariableNode::childCount() const { return 0; }
+
+    ASTNodePtr VariableNode::child(std::size_t index) const { childOutOfRange("Variable", index); }
 
     Common::JSON VariableNode::toJSON() const {
         Common::JSON json;
@@ -80,9 +189,17 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen BinaryNode::traverse() {
-        co_yield lhs;
-        co_yield rhs;
+    std::size_t BinaryNode::childCount() const { return 2; }
+
+    ASTNodePtr BinaryNode::child(std::size_t index) const {
+        switch (index) {
+            case 0:
+                return lhs;
+            case 1:
+                return rhs;
+            default:
+                childOutOfRange("Binary", index);
+        }
     }
 
     Common::JSON BinaryNode::toJSON() const {
@@ -94,7 +211,13 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen UnaryNode::traverse() { co_yield operand; }
+    std::size_t UnaryNode::childCount() const { return 1; }
+
+    ASTNodePtr UnaryNode::child(std::size_t index) const {
+        if (index != 0)
+            childOutOfRange("Unary", index);
+        return operand;
+    }
 
     Common::JSON UnaryNode::toJSON() const {
         Common::JSON json;
@@ -104,11 +227,14 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen MultiaryNode::traverse() {
-        co_yield object;
-        for (const auto &operand: operands) {
-            co_yield operand;
-        }
+    std::size_t MultiaryNode::childCount() const { return operands.size() + 1; }
+
+    ASTNodePtr MultiaryNode::child(std::size_t index) const {
+        if (index == 0)
+            return object;
+        if (index <= operands.size())
+            return operands[index - 1];
+        childOutOfRange("Multiary", index);
     }
 
     Common::JSON MultiaryNode::toJSON() const {
@@ -123,9 +249,17 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen CastNode::traverse() {
-        co_yield type;
-        co_yield operand;
+    std::size_t CastNode::childCount() const { return 2; }
+
+    ASTNodePtr CastNode::child(std::size_t index) const {
+        switch (index) {
+            case 0:
+                return type;
+            case 1:
+                return operand;
+            default:
+                childOutOfRange("Cast", index);
+        }
     }
 
     Common::JSON CastNode::toJSON() const {
@@ -137,10 +271,19 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen ConditionNode::traverse() {
-        co_yield condition;
-        co_yield trueBranch;
-        co_yield falseBranch;
+    std::size_t ConditionNode::childCount() const { return 3; }
+
+    ASTNodePtr ConditionNode::child(std::size_t index) const {
+        switch (index) {
+            case 0:
+                return condition;
+            case 1:
+                return trueBranch;
+            case 2:
+                return falseBranch;
+            default:
+                childOutOfRange("Condition", index);
+        }
     }
 
     Common::JSON ConditionNode::toJSON() const {
@@ -152,7 +295,13 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen MemberNode::traverse() { co_yield object; }
+    std::size_t MemberNode::childCount() const { return 1; }
+
+    ASTNodePtr MemberNode::child(std::size_t index) const {
+        if (index != 0)
+            childOutOfRange("Member", index);
+        return object;
+    }
 
     Common::JSON MemberNode::toJSON() const {
         Common::JSON json;
@@ -165,10 +314,19 @@ namespace TinyCobalt::AST {
 
     // StmtNode
 
-    ASTNodeGen IfNode::traverse() {
-        co_yield condition;
-        co_yield thenStmt;
-        co_yield elseStmt;
+    std::size_t IfNode::childCount() const { return 3; }
+
+    ASTNodePtr IfNode::child(std::size_t index) const {
+        switch (index) {
+            case 0:
+                return condition;
+            case 1:
+                return thenStmt;
+            case 2:
+                return elseStmt;
+            default:
+                childOutOfRange("If", index);
+        }
     }
 
     Common::JSON IfNode::toJSON() const {
@@ -180,9 +338,17 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen WhileNode::traverse() {
-        co_yield condition;
-        co_yield body;
+    std::size_t WhileNode::childCount() const { return 2; }
+
+    ASTNodePtr WhileNode::child(std::size_t index) const {
+        switch (index) {
+            case 0:
+                return condition;
+            case 1:
+                return body;
+            default:
+                childOutOfRange("While", index);
+        }
     }
 
     Common::JSON WhileNode::toJSON() const {
@@ -193,11 +359,21 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen ForNode::traverse() {
-        co_yield init;
-        co_yield condition;
-        co_yield step;
-        co_yield body;
+    std::size_t ForNode::childCount() const { return 4; }
+
+    ASTNodePtr ForNode::child(std::size_t index) const {
+        switch (index) {
+            case 0:
+                return init;
+            case 1:
+                return condition;
+            case 2:
+                return step;
+            case 3:
+                return body;
+            default:
+                childOutOfRange("For", index);
+        }
     }
 
     Common::JSON ForNode::toJSON() const {
@@ -210,7 +386,13 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen ReturnNode::traverse() { co_yield value; }
+    std::size_t ReturnNode::childCount() const { return 1; }
+
+    ASTNodePtr ReturnNode::child(std::size_t index) const {
+        if (index != 0)
+            childOutOfRange("Return", index);
+        return value;
+    }
 
     Common::JSON ReturnNode::toJSON() const {
         Common::JSON json;
@@ -219,10 +401,12 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen BlockNode::traverse() {
-        for (auto &stmt: stmts) {
-            co_yield stmt;
-        }
+    std::size_t BlockNode::childCount() const { return stmts.size(); }
+
+    ASTNodePtr BlockNode::child(std::size_t index) const {
+        if (index >= stmts.size())
+            childOutOfRange("Block", index);
+        return stmts[index];
     }
 
     Common::JSON BlockNode::toJSON() const {
@@ -235,7 +419,9 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen BreakNode::traverse() { co_return; }
+    std::size_t BreakNode::childCount() const { return 0; }
+
+    ASTNodePtr BreakNode::child(std::size_t index) const { childOutOfRange("Break", index); }
 
     Common::JSON BreakNode::toJSON() const {
         Common::JSON json;
@@ -243,7 +429,9 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen ContinueNode::traverse() { co_return; }
+    std::size_t ContinueNode::childCount() const { return 0; }
+
+    ASTNodePtr ContinueNode::child(std::size_t index) const { childOutOfRange("Continue", index); }
 
     Common::JSON ContinueNode::toJSON() const {
         Common::JSON json;
@@ -251,9 +439,17 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen VariableDefNode::traverse() {
-        co_yield type;
-        co_yield init;
+    std::size_t VariableDefNode::childCount() const { return 2; }
+
+    ASTNodePtr VariableDefNode::child(std::size_t index) const {
+        switch (index) {
+            case 0:
+                return type;
+            case 1:
+                return init;
+            default:
+                childOutOfRange("VariableDef", index);
+        }
     }
 
     Common::JSON VariableDefNode::toJSON() const {
@@ -265,12 +461,16 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen FuncDefNode::traverse() {
-        co_yield returnType;
-        for (auto &param: params) {
-            co_yield param;
-        }
-        co_yield body;
+    std::size_t FuncDefNode::childCount() const { return params.size() + 2; }
+
+    ASTNodePtr FuncDefNode::child(std::size_t index) const {
+        if (index == 0)
+            return returnType;
+        if (index <= params.size())
+            return params[index - 1];
+        if (index == params.size() + 1)
+            return body;
+        childOutOfRange("FuncDef", index);
     }
 
     Common::JSON FuncDefNode::toJSON() const {
@@ -286,10 +486,12 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen StructDefNode::traverse() {
-        for (auto &field: fields) {
-            co_yield field;
-        }
+    std::size_t StructDefNode::childCount() const { return fields.size(); }
+
+    ASTNodePtr StructDefNode::child(std::size_t index) const {
+        if (index >= fields.size())
+            childOutOfRange("StructDef", index);
+        return fields[index];
     }
 
     Common::JSON StructDefNode::toJSON() const {
@@ -303,17 +505,29 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen AliasDefNode::traverse() { co_yield type; }
+    std::size_t AliasDefNode::childCount() const { return 1; }
+
+    ASTNodePtr AliasDefNode::child(std::size_t index) const {
+        if (index != 0)
+            childOutOfRange("AliasDef", index);
+        return type;
+    }
 
     Common::JSON AliasDefNode::toJSON() const {
         Common::JSON json;
         json["type"] = "AliasDef";
         json["name"] = name;
-        json["type"] = type->toJSON();
+        json["type_node"] = type->toJSON();
         return json;
     }
 
-    ASTNodeGen ExprStmtNode::traverse() { co_yield expr; }
+    std::size_t ExprStmtNode::childCount() const { return 1; }
+
+    ASTNodePtr ExprStmtNode::child(std::size_t index) const {
+        if (index != 0)
+            childOutOfRange("ExprStmt", index);
+        return expr;
+    }
 
     Common::JSON ExprStmtNode::toJSON() const {
         Common::JSON json;
@@ -322,7 +536,9 @@ namespace TinyCobalt::AST {
         return json;
     }
 
-    ASTNodeGen EmptyStmtNode::traverse() { co_return; }
+    std::size_t EmptyStmtNode::childCount() const { return 0; }
+
+    ASTNodePtr EmptyStmtNode::child(std::size_t index) const { childOutOfRange("EmptyStmt", index); }
 
     Common::JSON EmptyStmtNode::toJSON() const {
         Common::JSON json;
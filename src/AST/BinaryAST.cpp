@@ -0,0 +1,815 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "AST/BinaryAST.h"
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include "AST/ASTNodeDecl.h"
+#include "AST/StmtNode.h"
+#include "Common/AtomicFile.h"
+#include "Common/Symbol.h"
+
+namespace TinyCobalt::AST {
+    namespace {
+        constexpr char kMagic[4] = {'T', 'C', 'A', 'S'};
+
+        struct Header {
+            char magic[4];
+            std::uint32_t version;
+            // Changes whenever node kinds are added.
+            std::uint32_t node_kinds;
+            std::uint32_t nodes;
+            std::uint32_t strings;
+            std::uint32_t reserved;
+            std::uint64_t string_size;
+            std::uint64_t records_size;
+        };
+
+        template<typename T>
+        T load(const char *ptr) {
+            T value;
+            std::memcpy(&value, ptr, sizeof(value));
+            return value;
+        }
+
+        [[noreturn]] void malformed(const std::string &what) { throw std::runtime_error("BinaryAST: " + what); }
+
+        class Writer {
+        public:
+            explicit Writer(const FlatAST &ast) : ast_(ast) {}
+
+            std::vector<char> write() {
+                std::vector<std::uint32_t> offsets;
+                offsets.reserve(ast_.size());
+                for (NodeId id = 0; id < ast_.size(); ++id) {
+                    offsets.push_back(static_cast<std::uint32_t>(records_.size()));
+                    writeNode(id);
+                }
+
+                std::vector<char> out;
+                Header header{};
+                std::memcpy(header.magic, kMagic, sizeof(kMagic));
+                header.version = BinaryAST::kVersion;
+                header.node_kinds = kNodeKindCount;
+                header.nodes = static_cast<std::uint32_t>(ast_.size());
+                header.strings = static_cast<std::uint32_t>(strings_.size());
+                header.string_size = string_data_.size();
+                header.records_size = records_.size();
+                append(out, &header, sizeof(header));
+                std::uint32_t string_offset = 0;
+                for (auto text: strings_) {
+                    append(out, &string_offset, sizeof(string_offset));
+                    string_offset += static_cast<std::uint32_t>(text.size());
+                }
+                append(out, &string_offset, sizeof(string_offset));
+                append(out, string_data_.data(), string_data_.size());
+                append(out, offsets.data(), offsets.size() * sizeof(std::uint32_t));
+                append(out, records_.data(), records_.size());
+                return out;
+            }
+
+        private:
+            static void append(std::vector<char> &out, const void *data, std::size_t size) {
+                auto *bytes = static_cast<const char *>(data);
+                out.insert(out.end(), bytes, bytes + size);
+            }
+
+            void varint(std::uint64_t value) {
+                while (value >= 0x80) {
+                    records_.push_back(static_cast<char>(value | 0x80));
+                    value >>= 7;
+                }
+                records_.push_back(static_cast<char>(value));
+            }
+
+            void ref(NodeId parent, NodeId child) {
+                if (child == kNullNode)
+                    return varint(0);
+                auto delta = static_cast<std::int64_t>(parent) - static_cast<std::int64_t>(child);
+                varint((static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63));
+            }
+
+            void list(std::span<const NodeId> children) {
+                varint(children.size());
+                for (auto child: children) {
+                    auto *bytes = reinterpret_cast<const char *>(&child);
+                    records_.insert(records_.end(), bytes, bytes + sizeof(child));
+                }
+            }
+
+            void list(FlatAST::List list) { this->list(ast_.list(list)); }
+
+            void string(const Common::Symbol &symbol) {
+                auto [it, inserted] = string_index_.try_emplace(symbol.view(), strings_.size());
+                if (inserted) {
+                    strings_.push_back(symbol.view());
+                    string_data_.insert(string_data_.end(), symbol.view().begin(), symbol.view().end());
+                }
+                varint(it->second);
+            }
+
+            template<typename E>
+            void enumValue(E value) {
+                varint(static_cast<std::uint64_t>(value));
+            }
+
+            void writeNode(NodeId id) {
+                auto kind = ast_.kind(id);
+                records_.push_back(static_cast<char>(kind));
+                varint(ast_.location(id).begin);
+                varint(ast_.location(id).end);
+                switch (kind) {
+                    case NodeKind::SimpleType:
+                        string(ast_.getSimpleType(id).name);
+                        break;
+                    case NodeKind::FuncType:
+                        ref(id, ast_.getFuncType(id).returnType);
+                        list(ast_.getFuncType(id).paramTypes);
+                        break;
+                    case NodeKind::ComplexType:
+                        string(ast_.getComplexType(id).templateName);
+                        list(ast_.getComplexType(id).templateArgs);
+                        break;
+                    case NodeKind::ConstExpr: {
+                        const auto &record = ast_.getConstExpr(id);
+                        enumValue(record.type);
+                        std::visit(
+                                [this](const auto &value) {
+                                    using T = std::decay_t<decltype(value)>;
+                                    if constexpr (std::is_same_v<T, double>)
+                                        varint(std::bit_cast<std::uint64_t>(value));
+                                    else if constexpr (std::is_same_v<T, Common::Symbol>)
+                                        string(value);
+                                    else if constexpr (std::is_same_v<T, char>)
+                                        varint(static_cast<unsigned char>(value));
+                                    else
+                                        varint(value);
+                                },
+                                record.value);
+                        break;
+                    }
+                    case NodeKind::Variable:
+                        string(ast_.getVariable(id).name);
+                        break;
+                    case NodeKind::Binary:
+                        enumValue(ast_.getBinary(id).op);
+                        ref(id, ast_.getBinary(id).lhs);
+                        ref(id, ast_.getBinary(id).rhs);
+                        break;
+                    case NodeKind::Unary:
+                        enumValue(ast_.getUnary(id).op);
+                        ref(id, ast_.getUnary(id).operand);
+                        break;
+                    case NodeKind::Multiary:
+                        enumValue(ast_.getMultiary(id).op);
+                        ref(id, ast_.getMultiary(id).object);
+                        list(ast_.getMultiary(id).operands);
+                        break;
+                    case NodeKind::Cast:
+                        enumValue(ast_.getCast(id).op);
+                        ref(id, ast_.getCast(id).type);
+                        ref(id, ast_.getCast(id).operand);
+                        break;
+                    case NodeKind::Condition:
+                        ref(id, ast_.getCondition(id).condition);
+                        ref(id, ast_.getCondition(id).trueBranch);
+                        ref(id, ast_.getCondition(id).falseBranch);
+                        break;
+                    case NodeKind::Member:
+                        enumValue(ast_.getMember(id).op);
+                        ref(id, ast_.getMember(id).object);
+                        string(ast_.getMember(id).member);
+                        break;
+                    case NodeKind::If:
+                        ref(id, ast_.getIf(id).condition);
+                        ref(id, ast_.getIf(id).thenStmt);
+                        ref(id, ast_.getIf(id).elseStmt);
+                        break;
+                    case NodeKind::While:
+                        ref(id, ast_.getWhile(id).condition);
+                        ref(id, ast_.getWhile(id).body);
+                        break;
+                    case NodeKind::For:
+                        ref(id, ast_.getFor(id).init);
+                        ref(id, ast_.getFor(id).condition);
+                        ref(id, ast_.getFor(id).step);
+                        ref(id, ast_.getFor(id).body);
+                        break;
+                    case NodeKind::Return:
+                        ref(id, ast_.getReturn(id).value);
+                        break;
+                    case NodeKind::Block:
+                        list(ast_.getBlock(id).stmts);
+                        break;
+                    case NodeKind::VariableDef:
+                        ref(id, ast_.getVariableDef(id).type);
+                        string(ast_.getVariableDef(id).name);
+                        ref(id, ast_.getVariableDef(id).init);
+                        break;
+                    case NodeKind::FuncDef:
+                        ref(id, ast_.getFuncDef(id).returnType);
+                        string(ast_.getFuncDef(id).name);
+                        list(ast_.getFuncDef(id).params);
+                        ref(id, ast_.getFuncDef(id).body);
+                        break;
+                    case NodeKind::StructDef:
+                        string(ast_.getStructDef(id).name);
+                        list(ast_.getStructDef(id).fields);
+                        break;
+                    case NodeKind::AliasDef:
+                        string(ast_.getAliasDef(id).name);
+                        ref(id, ast_.getAliasDef(id).type);
+                        break;
+                    case NodeKind::ExprStmt:
+                        ref(id, ast_.getExprStmt(id).expr);
+                        break;
+                    case NodeKind::ASTRoot:
+                        list(ast_.children());
+                        break;
+                    case NodeKind::Break:
+                    case NodeKind::Continue:
+                    case NodeKind::EmptyStmt:
+                        break;
+                }
+            }
+
+            const FlatAST &ast_;
+            std::vector<char> records_;
+            std::vector<std::string_view> strings_;
+            std::vector<char> string_data_;
+            std::unordered_map<std::string_view, std::uint32_t> string_index_;
+        };
+
+        // Reads the fields of one record. Every read is bounds-checked, so a malformed file throws instead of
+        // reading past the buffer.
+        class Cursor {
+        public:
+            Cursor(const BinaryAST &ast, NodeId id) : id_(id), nodes_(ast.size()) {
+                auto bytes = ast.record(id);
+                ptr_ = reinterpret_cast<const unsigned char *>(bytes.data());
+                end_ = ptr_ + bytes.size();
+                auto tag = byte();
+                if (tag >= kNodeKindCount)
+                    malformed("bad kind of node " + std::to_string(id));
+                kind_ = static_cast<NodeKind>(tag);
+                auto begin = static_cast<Common::SourceOffset>(varint());
+                location_ = Common::Location(begin, static_cast<Common::SourceOffset>(varint()));
+            }
+
+            NodeKind kind() const { return kind_; }
+            const Common::Location &location() const { return location_; }
+
+            std::uint64_t varint() {
+                std::uint64_t value = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    auto b = byte();
+                    value |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+                    if (!(b & 0x80))
+                        return value;
+                }
+                malformed("overlong varint in node " + std::to_string(id_));
+            }
+
+            NodeId ref() {
+                auto value = varint();
+                if (value == 0)
+                    return kNullNode;
+                auto delta = static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+                return checked(static_cast<std::int64_t>(id_) - delta);
+            }
+
+            // Skip the header of a list and return its size. Its ids follow, read with listAt().
+            std::uint64_t listSize() {
+                auto size = varint();
+                if (size > static_cast<std::uint64_t>(end_ - ptr_) / sizeof(NodeId))
+                    malformed("bad list in node " + std::to_string(id_));
+                list_ = ptr_;
+                ptr_ += size * sizeof(NodeId);
+                return size;
+            }
+
+            NodeId listAt(std::uint64_t index) const {
+                auto child = load<NodeId>(reinterpret_cast<const char *>(list_ + index * sizeof(NodeId)));
+                return child == kNullNode ? kNullNode : checked(child);
+            }
+
+            std::vector<NodeId> list() {
+                auto size = listSize();
+                std::vector<NodeId> ids;
+                ids.reserve(size);
+                for (std::uint64_t i = 0; i < size; ++i)
+                    ids.push_back(listAt(i));
+                return ids;
+            }
+
+            template<typename E>
+            E enumValue() {
+                auto value = magic_enum::enum_cast<E>(static_cast<std::underlying_type_t<E>>(varint()));
+                if (!value)
+                    malformed("bad operator in node " + std::to_string(id_));
+                return *value;
+            }
+
+        private:
+            // Ids are in post-order after the root, so a child comes before its parent, or after the root. Any other
+            // reference could close a cycle.
+            NodeId checked(std::int64_t child) const {
+                auto end = id_ == 0 ? static_cast<std::int64_t>(nodes_) : static_cast<std::int64_t>(id_);
+                if (child <= 0 || child >= end)
+                    malformed("bad child of node " + std::to_string(id_));
+                return static_cast<NodeId>(child);
+            }
+
+            unsigned char byte() {
+                if (ptr_ == end_)
+                    malformed("truncated node " + std::to_string(id_));
+                return *ptr_++;
+            }
+
+            NodeId id_;
+            std::size_t nodes_;
+            const unsigned char *ptr_;
+            const unsigned char *end_;
+            // The ids of the last list.
+            const unsigned char *list_ = nullptr;
+            NodeKind kind_;
+            Common::Location location_;
+        };
+
+        // Reads the children of a record, which are stored in the order of traverse(), up to the one at index.
+        class ChildWalker {
+        public:
+            ChildWalker(const BinaryAST &ast, NodeId id, std::size_t index) : cursor_(ast, id), index_(index) {}
+
+            // Return the number of children, or index + 1 if the child at index was found.
+            std::size_t walk() {
+                switch (cursor_.kind()) {
+                    case NodeKind::FuncType:
+                        if (refs(1))
+                            list();
+                        break;
+                    case NodeKind::FuncDef:
+                        if (refs(1)) {
+                            skip();
+                            if (list())
+                                refs(1);
+                        }
+                        break;
+                    case NodeKind::ComplexType:
+                    case NodeKind::StructDef:
+                        skip();
+                        list();
+                        break;
+                    case NodeKind::Binary:
+                    case NodeKind::Cast:
+                        skip();
+                        refs(2);
+                        break;
+                    case NodeKind::Unary:
+                    case NodeKind::Member:
+                    case NodeKind::AliasDef:
+                        skip();
+                        refs(1);
+                        break;
+                    case NodeKind::Multiary:
+                        skip();
+                        if (refs(1))
+                            list();
+                        break;
+                    case NodeKind::Condition:
+                    case NodeKind::If:
+                        refs(3);
+                        break;
+                    case NodeKind::While:
+                        refs(2);
+                        break;
+                    case NodeKind::For:
+                        refs(4);
+                        break;
+                    case NodeKind::Return:
+                    case NodeKind::ExprStmt:
+                        refs(1);
+                        break;
+                    case NodeKind::Block:
+                    case NodeKind::ASTRoot:
+                        list();
+                        break;
+                    case NodeKind::VariableDef:
+                        if (refs(1)) {
+                            skip();
+                            refs(1);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                return count_;
+            }
+
+            NodeId found() const { return found_; }
+
+        private:
+            // Each returns false once the child at index is found.
+            bool refs(std::size_t count) {
+                for (std::size_t i = 0; i < count; ++i)
+                    if (!take(cursor_.ref()))
+                        return false;
+                return true;
+            }
+
+            // The list is skipped as a whole unless the child at index is in it.
+            bool list() {
+                auto size = cursor_.listSize();
+                if (index_ - count_ < size) {
+                    found_ = cursor_.listAt(index_ - count_);
+                    count_ = index_ + 1;
+                    return false;
+                }
+                count_ += size;
+                return true;
+            }
+
+            // A field that is not a child: an operator or a string index.
+            void skip() { cursor_.varint(); }
+
+            bool take(NodeId id) {
+                if (count_++ < index_)
+                    return true;
+                found_ = id;
+                return false;
+            }
+
+            Cursor cursor_;
+            std::size_t index_;
+            std::size_t count_ = 0;
+            NodeId found_ = kNullNode;
+        };
+
+        class Builder {
+        public:
+            // Strings are interned into pool as they are first used.
+            explicit Builder(const BinaryAST &ast, Common::StringPool &pool) :
+                ast_(ast), pool_(pool), symbols_(ast.strings()) {}
+
+            ASTNodePtr node(NodeId id) {
+                switch (ast_.kind(id)) {
+                    case NodeKind::SimpleType:
+                    case NodeKind::FuncType:
+                    case NodeKind::ComplexType:
+                        return type(id);
+                    case NodeKind::ConstExpr:
+                    case NodeKind::Variable:
+                    case NodeKind::Binary:
+                    case NodeKind::Unary:
+                    case NodeKind::Multiary:
+                    case NodeKind::Cast:
+                    case NodeKind::Condition:
+                    case NodeKind::Member:
+                        return expr(id);
+                    case NodeKind::ASTRoot:
+                        if (id != 0)
+                            malformed("node " + std::to_string(id) + " is a second root");
+                        return root();
+                    default:
+                        return stmt(id);
+                }
+            }
+
+            ASTRootPtr root() {
+                Cursor cursor(ast_, 0);
+                expect(cursor, NodeKind::ASTRoot);
+                std::vector<StmtNodePtr> children;
+                for (auto id: cursor.list())
+                    children.push_back(stmt(id));
+                auto root = std::make_shared<ASTRootNode>(std::move(children));
+                root->location = cursor.location();
+                return root;
+            }
+
+        private:
+            static void expect(const Cursor &cursor, NodeKind kind) {
+                if (cursor.kind() != kind)
+                    malformed("unexpected " + std::string(magic_enum::enum_name(cursor.kind())) + " node");
+            }
+
+            template<typename T, typename... Args>
+            static std::shared_ptr<T> make(const Cursor &cursor, Args &&...args) {
+                auto node = std::make_shared<T>(std::forward<Args>(args)...);
+                node->location = cursor.location();
+                return node;
+            }
+
+            Common::Symbol symbol(Cursor &cursor) {
+                auto index = cursor.varint();
+                if (index >= symbols_.size())
+                    malformed("bad string index " + std::to_string(index));
+                auto &symbol = symbols_[index];
+                if (!symbol)
+                    symbol = pool_.intern(ast_.string(static_cast<std::uint32_t>(index)));
+                return *symbol;
+            }
+
+            TypeNodePtr type(NodeId id) {
+                if (id == kNullNode)
+                    return nullptr;
+                Cursor cursor(ast_, id);
+                switch (cursor.kind()) {
+                    case NodeKind::SimpleType:
+                        return make<SimpleTypeNode>(cursor, symbol(cursor));
+                    case NodeKind::FuncType: {
+                        auto ret = type(cursor.ref());
+                        std::vector<TypeNodePtr> params;
+                        for (auto param: cursor.list())
+                            params.push_back(type(param));
+                        return make<FuncTypeNode>(cursor, std::move(ret), std::move(params));
+                    }
+                    case NodeKind::ComplexType: {
+                        auto name = symbol(cursor);
+                        std::vector<ComplexTypeNode::TemplateArgType> args;
+                        for (auto arg: cursor.list()) {
+                            if (ast_.kind(arg) == NodeKind::ConstExpr)
+                                args.emplace_back(constExpr(arg));
+                            else
+                                args.emplace_back(type(arg));
+                        }
+                        return make<ComplexTypeNode>(cursor, name, std::move(args));
+                    }
+                    default:
+                        malformed("node " + std::to_string(id) + " is not a type");
+                }
+            }
+
+            ConstExprPtr constExpr(NodeId id) {
+                Cursor cursor(ast_, id);
+                expect(cursor, NodeKind::ConstExpr);
+                auto type = cursor.enumValue<ConstExprType>();
+                ConstExprNode::Value value;
+                switch (type) {
+                    case ConstExprType::Int:
+                    case ConstExprType::HexInt:
+                    case ConstExprType::OctInt:
+                    case ConstExprType::BinInt:
+                        value = cursor.varint();
+                        break;
+                    case ConstExprType::Float:
+                        value = std::bit_cast<double>(cursor.varint());
+                        break;
+                    case ConstExprType::Bool:
+                        value = cursor.varint() != 0;
+                        break;
+                    case ConstExprType::Char:
+                        value = static_cast<char>(cursor.varint());
+                        break;
+                    case ConstExprType::String:
+                        value = symbol(cursor);
+                        break;
+                }
+                return make<ConstExprNode>(cursor, type, std::move(value));
+            }
+
+            ExprNodePtr expr(NodeId id) {
+                if (id == kNullNode)
+                    return nullptr;
+                if (ast_.kind(id) == NodeKind::ConstExpr)
+                    return constExpr(id);
+                Cursor cursor(ast_, id);
+                switch (cursor.kind()) {
+                    case NodeKind::Variable:
+                        return make<VariableNode>(cursor, symbol(cursor));
+                    case NodeKind::Binary: {
+                        auto op = cursor.enumValue<BinaryOp>();
+                        auto lhs = expr(cursor.ref());
+                        auto rhs = expr(cursor.ref());
+                        return make<BinaryNode>(cursor, std::move(lhs), op, std::move(rhs));
+                    }
+                    case NodeKind::Unary: {
+                        auto op = cursor.enumValue<UnaryOp>();
+                        return make<UnaryNode>(cursor, op, expr(cursor.ref()));
+                    }
+                    case NodeKind::Multiary: {
+                        auto op = cursor.enumValue<MultiaryOp>();
+                        auto object = expr(cursor.ref());
+                        std::vector<ExprNodePtr> operands;
+                        for (auto operand: cursor.list())
+                            operands.push_back(expr(operand));
+                        return make<MultiaryNode>(cursor, op, std::move(object), std::move(operands));
+                    }
+                    case NodeKind::Cast: {
+                        auto op = cursor.enumValue<CastType>();
+                        auto cast_type = type(cursor.ref());
+                        return make<CastNode>(cursor, op, std::move(cast_type), expr(cursor.ref()));
+                    }
+                    case NodeKind::Condition: {
+                        auto condition = expr(cursor.ref());
+                        auto true_branch = expr(cursor.ref());
+                        auto false_branch = expr(cursor.ref());
+                        return make<ConditionNode>(cursor, std::move(condition), std::move(true_branch),
+                                                   std::move(false_branch));
+                    }
+                    case NodeKind::Member: {
+                        auto op = cursor.enumValue<BinaryOp>();
+                        auto object = expr(cursor.ref());
+                        return make<MemberNode>(cursor, std::move(object), op, symbol(cursor));
+                    }
+                    default:
+                        malformed("node " + std::to_string(id) + " is not an expression");
+                }
+            }
+
+            // Variable definitions, parameters and fields share a record layout.
+            template<typename T>
+            std::shared_ptr<T> variableDef(NodeId id) {
+                Cursor cursor(ast_, id);
+                expect(cursor, NodeKind::VariableDef);
+                auto def_type = type(cursor.ref());
+                auto name = symbol(cursor);
+                return make<T>(cursor, std::move(def_type), name, expr(cursor.ref()));
+            }
+
+            StmtNodePtr stmt(NodeId id) {
+                if (id == kNullNode)
+                    return nullptr;
+                if (ast_.kind(id) == NodeKind::VariableDef)
+                    return variableDef<VariableDefNode>(id);
+                Cursor cursor(ast_, id);
+                switch (cursor.kind()) {
+                    case NodeKind::If: {
+                        auto condition = expr(cursor.ref());
+                        auto then_stmt = stmt(cursor.ref());
+                        auto else_stmt = stmt(cursor.ref());
+                        return make<IfNode>(cursor, std::move(condition), std::move(then_stmt), std::move(else_stmt));
+                    }
+                    case NodeKind::While: {
+                        auto condition = expr(cursor.ref());
+                        return make<WhileNode>(cursor, std::move(condition), stmt(cursor.ref()));
+                    }
+                    case NodeKind::For: {
+                        auto init = expr(cursor.ref());
+                        auto condition = expr(cursor.ref());
+                        auto step = expr(cursor.ref());
+                        return make<ForNode>(cursor, std::move(init), std::move(condition), std::move(step),
+                                             stmt(cursor.ref()));
+                    }
+                    case NodeKind::Return:
+                        return make<ReturnNode>(cursor, expr(cursor.ref()));
+                    case NodeKind::Block: {
+                        std::vector<StmtNodePtr> stmts;
+                        for (auto child: cursor.list())
+                            stmts.push_back(stmt(child));
+                        return make<BlockNode>(cursor, std::move(stmts));
+                    }
+                    case NodeKind::Break:
+                        return make<BreakNode>(cursor);
+                    case NodeKind::Continue:
+                        return make<ContinueNode>(cursor);
+                    case NodeKind::FuncDef: {
+                        auto ret = type(cursor.ref());
+                        auto name = symbol(cursor);
+                        std::vector<FuncDefNode::ParamsElem> params;
+                        for (auto param: cursor.list())
+                            params.push_back(variableDef<FuncDefNode::ParamsElemNode>(param));
+                        return make<FuncDefNode>(cursor, std::move(ret), name, std::move(params), stmt(cursor.ref()));
+                    }
+                    case NodeKind::StructDef: {
+                        auto name = symbol(cursor);
+                        std::vector<StructDefNode::FieldsElem> fields;
+                        for (auto field: cursor.list())
+                            fields.push_back(variableDef<StructDefNode::FieldsElemNode>(field));
+                        return make<StructDefNode>(cursor, name, std::move(fields));
+                    }
+                    case NodeKind::AliasDef: {
+                        auto name = symbol(cursor);
+                        return make<AliasDefNode>(cursor, name, type(cursor.ref()));
+                    }
+                    case NodeKind::ExprStmt:
+                        return make<ExprStmtNode>(cursor, expr(cursor.ref()));
+                    case NodeKind::EmptyStmt:
+                        return make<EmptyStmtNode>(cursor);
+                    default:
+                        malformed("node " + std::to_string(id) + " is not a statement");
+                }
+            }
+
+            const BinaryAST &ast_;
+            Common::StringPool &pool_;
+            std::vector<std::optional<Common::Symbol>> symbols_;
+        };
+    } // namespace
+
+    NodeKind BinaryASTNode::kind() const { return ast_->kind(id_); }
+
+    Common::Location BinaryASTNode::location() const { return ast_->location(id_); }
+
+    std::size_t BinaryASTNode::childCount() const {
+        return ChildWalker(*ast_, id_, std::numeric_limits<std::size_t>::max()).walk();
+    }
+
+    ASTNodePtr BinaryASTNode::child(std::size_t index) const {
+        ChildWalker walker(*ast_, id_, index);
+        if (walker.walk() <= index)
+            throw std::out_of_range("BinaryASTNode: no child " + std::to_string(index));
+        return ast_->child(walker.found());
+    }
+
+    void *BinaryASTNode::thisPointer() const {
+        return const_cast<void *>(static_cast<const void *>(ast_->record(id_).data()));
+    }
+
+    // The subtree is built into node structs, whose names only live until their JSON is written.
+    Common::JSON BinaryASTNode::toJSON() const {
+        Common::StringPool pool;
+        return Builder(*ast_, pool).node(id_)->toJSON();
+    }
+
+    std::vector<char> BinaryAST::serialize(const FlatAST &ast) { return Writer(ast).write(); }
+
+    bool BinaryAST::store(const FlatAST &ast, const std::string &path) {
+        auto bytes = serialize(ast);
+        return Common::writeFileAtomically(path, [&bytes](std::ostream &os) {
+            os.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        });
+    }
+
+    BinaryAST::BinaryAST(LexerParser::SourceBuffer buffer) : buffer_(std::move(buffer)) {
+        const char *begin = buffer_.begin();
+        std::size_t size = buffer_.size();
+        if (size < sizeof(Header))
+            malformed("truncated header");
+        auto header = load<Header>(begin);
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0)
+            malformed("bad magic");
+        if (header.version != kVersion || header.node_kinds != kNodeKindCount)
+            malformed("unsupported version");
+        // Sizes are checked one section at a time, so that the sums cannot overflow.
+        std::size_t rest = size - sizeof(Header);
+        std::size_t string_offsets = (static_cast<std::size_t>(header.strings) + 1) * sizeof(std::uint32_t);
+        if (string_offsets > rest || header.string_size > rest - string_offsets)
+            malformed("truncated string table");
+        rest -= string_offsets + header.string_size;
+        std::size_t node_offsets = static_cast<std::size_t>(header.nodes) * sizeof(std::uint32_t);
+        if (header.nodes == 0 || node_offsets > rest || header.records_size != rest - node_offsets)
+            malformed("truncated records");
+        nodes_ = header.nodes;
+        strings_ = header.strings;
+        string_offsets_ = begin + sizeof(Header);
+        string_data_ = string_offsets_ + string_offsets;
+        string_size_ = header.string_size;
+        node_offsets_ = string_data_ + string_size_;
+        records_ = node_offsets_ + node_offsets;
+        records_size_ = header.records_size;
+    }
+
+    BinaryAST BinaryAST::map(const std::string &path) { return BinaryAST(LexerParser::SourceBuffer::map(path)); }
+
+    NodeKind BinaryAST::kind(NodeId id) const {
+        auto bytes = record(id);
+        if (bytes.empty() || static_cast<unsigned char>(bytes.front()) >= kNodeKindCount)
+            malformed("bad kind of node " + std::to_string(id));
+        return static_cast<NodeKind>(bytes.front());
+    }
+
+    Common::Location BinaryAST::location(NodeId id) const { return Cursor(*this, id).location(); }
+
+    ASTNodePtr BinaryAST::child(NodeId id) const {
+        if (id == kNullNode)
+            return nullptr;
+        return node(id);
+    }
+
+    std::span<const char> BinaryAST::record(NodeId id) const {
+        if (id >= nodes_)
+            malformed("no node " + std::to_string(id));
+        auto offset = load<std::uint32_t>(node_offsets_ + id * sizeof(std::uint32_t));
+        if (offset >= records_size_)
+            malformed("bad offset of node " + std::to_string(id));
+        return {records_ + offset, records_size_ - offset};
+    }
+
+    std::string_view BinaryAST::string(std::uint32_t index) const {
+        if (index >= strings_)
+            malformed("no string " + std::to_string(index));
+        auto begin = load<std::uint32_t>(string_offsets_ + index * sizeof(std::uint32_t));
+        auto end = load<std::uint32_t>(string_offsets_ + (index + 1) * sizeof(std::uint32_t));
+        if (begin > end || end > string_size_)
+            malformed("bad string " + std::to_string(index));
+        return {string_data_ + begin, end - begin};
+    }
+
+    ASTRootPtr BinaryAST::materialize() const {
+        auto pool = std::make_shared<Common::StringPool>();
+        auto root = Builder(*this, *pool).root();
+        root->resources.emplace_back(std::move(pool));
+        return root;
+    }
+
+} // namespace TinyCobalt::AST
@@ -0,0 +1,510 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "AST/FlatAST.h"
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include "Common/Assert.h"
+#include "Common/Utility.h"
+
+namespace TinyCobalt::AST {
+
+    NodeKind FlatNode::kind() const { return ast_->kind(id_); }
+
+    const Common::Location &FlatNode::location() const { return ast_->location(id_); }
+
+    std::size_t FlatNode::childCount() const {
+        const auto &ast = *ast_;
+        switch (kind()) {
+            case NodeKind::FuncType:
+                return ast.getFuncType(id_).paramTypes.size + 1;
+            case NodeKind::ComplexType:
+                return ast.getComplexType(id_).templateArgs.size;
+            case NodeKind::Multiary:
+                return ast.getMultiary(id_).operands.size + 1;
+            case NodeKind::Block:
+                return ast.getBlock(id_).stmts.size;
+            case NodeKind::FuncDef:
+                return ast.getFuncDef(id_).params.size + 2;
+            case NodeKind::StructDef:
+                return ast.getStructDef(id_).fields.size;
+            case NodeKind::ASTRoot:
+                return ast.children().size();
+            case NodeKind::Unary:
+            case NodeKind::Member:
+            case NodeKind::Return:
+            case NodeKind::AliasDef:
+            case NodeKind::ExprStmt:
+                return 1;
+            case NodeKind::Binary:
+            case NodeKind::Cast:
+            case NodeKind::While:
+            case NodeKind::VariableDef:
+                return 2;
+            case NodeKind::Condition:
+            case NodeKind::If:
+                return 3;
+            case NodeKind::For:
+                return 4;
+            default:
+                return 0;
+        }
+    }
+
+    ASTNodePtr FlatNode::child(std::size_t index) const {
+        if (index >= childCount())
+            throw std::out_of_range("FlatNode: no child " + std::to_string(index));
+        const auto &ast = *ast_;
+        auto at = [&ast](FlatAST::List list, std::size_t i) { return ast.list(list)[i]; };
+        auto id = kNullNode;
+        switch (kind()) {
+            case NodeKind::FuncType: {
+                const auto &record = ast.getFuncType(id_);
+                id = index == 0 ? record.returnType : at(record.paramTypes, index - 1);
+                break;
+            }
+            case NodeKind::ComplexType:
+                id = at(ast.getComplexType(id_).templateArgs, index);
+                break;
+            case NodeKind::Binary:
+                id = std::array{ast.getBinary(id_).lhs, ast.getBinary(id_).rhs}[index];
+                break;
+            case NodeKind::Unary:
+                id = ast.getUnary(id_).operand;
+                break;
+            case NodeKind::Multiary: {
+                const auto &record = ast.getMultiary(id_);
+                id = index == 0 ? record.object : at(record.operands, index - 1);
+                break;
+            }
+            case NodeKind::Cast:
+                id = std::array{ast.getCast(id_).type, ast.getCast(id_).operand}[index];
+                break;
+            case NodeKind::Condition: {
+                const auto &record = ast.getCondition(id_);
+                id = std::array{record.condition, record.trueBranch, record.falseBranch}[index];
+                break;
+            }
+            case NodeKind::Member:
+                id = ast.getMember(id_).object;
+                break;
+            case NodeKind::If: {
+                const auto &record = ast.getIf(id_);
+                id = std::array{record.condition, record.thenStmt, record.elseStmt}[index];
+                break;
+            }
+            case NodeKind::While:
+                id = std::array{ast.getWhile(id_).condition, ast.getWhile(id_).body}[index];
+                break;
+            case NodeKind::For: {
+                const auto &record = ast.getFor(id_);
+                id = std::array{record.init, record.condition, record.step, record.body}[index];
+                break;
+            }
+            case NodeKind::Return:
+                id = ast.getReturn(id_).value;
+                break;
+            case NodeKind::Block:
+                id = at(ast.getBlock(id_).stmts, index);
+                break;
+            case NodeKind::VariableDef:
+                id = std::array{ast.getVariableDef(id_).type, ast.getVariableDef(id_).init}[index];
+                break;
+            case NodeKind::FuncDef: {
+                const auto &record = ast.getFuncDef(id_);
+                if (index == 0)
+                    id = record.returnType;
+                else if (index <= record.params.size)
+                    id = at(record.params, index - 1);
+                else
+                    id = record.body;
+                break;
+            }
+            case NodeKind::StructDef:
+                id = at(ast.getStructDef(id_).fields, index);
+                break;
+            case NodeKind::AliasDef:
+                id = ast.getAliasDef(id_).type;
+                break;
+            case NodeKind::ExprStmt:
+                id = ast.getExprStmt(id_).expr;
+                break;
+            case NodeKind::ASTRoot:
+                id = ast.children()[index];
+                break;
+            default:
+                break;
+        }
+        return ast.child(id);
+    }
+
+    void *FlatNode::thisPointer() const {
+        switch (kind()) {
+#define REG_FLAT_POINTER(Name, ...)                                                                                    \
+    case NodeKind::Name:                                                                                               \
+        return const_cast<void *>(static_cast<const void *>(&ast_->get##Name(id_)));
+            TINY_COBALT_AST_NODES(REG_FLAT_POINTER)
+#undef REG_FLAT_POINTER
+        }
+        return nullptr;
+    }
+
+    // Same output as the toJSON() of the node structs.
+    Common::JSON FlatNode::toJSON() const {
+        const auto &ast = *ast_;
+        auto of = [&ast](NodeId id) -> Common::JSON { return id == kNullNode ? nullptr : ast.node(id)->toJSON(); };
+        auto ofList = [&](FlatAST::List list) {
+            auto res = Common::JSON::array();
+            for (auto id: ast.list(list))
+                res.push_back(of(id));
+            return res;
+        };
+        Common::JSON json;
+        switch (kind()) {
+            case NodeKind::SimpleType:
+                json["type"] = "SimpleType";
+                json["name"] = ast.getSimpleType(id_).name;
+                break;
+            case NodeKind::FuncType: {
+                const auto &record = ast.getFuncType(id_);
+                json["type"] = "FuncType";
+                json["return_type"] = of(record.returnType);
+                json["param_types"] = ofList(record.paramTypes);
+                break;
+            }
+            case NodeKind::ComplexType: {
+                const auto &record = ast.getComplexType(id_);
+                json["type"] = "ComplexType";
+                json["template_name"] = record.templateName;
+                json["template_args"] = ofList(record.templateArgs);
+                break;
+            }
+            case NodeKind::ConstExpr: {
+                const auto &record = ast.getConstExpr(id_);
+                json["type"] = "ConstExpr";
+                json["value"] = ConstExprNode(record.type, record.value).text();
+                json["expr_type"] = magic_enum::enum_name(record.type);
+                break;
+            }
+            case NodeKind::Variable:
+                json["type"] = "Variable";
+                json["name"] = ast.getVariable(id_).name;
+                break;
+            case NodeKind::Binary: {
+                const auto &record = ast.getBinary(id_);
+                json["type"] = "Binary";
+                json["op"] = magic_enum::enum_name(record.op);
+                json["lhs"] = of(record.lhs);
+                json["rhs"] = of(record.rhs);
+                break;
+            }
+            case NodeKind::Unary: {
+                const auto &record = ast.getUnary(id_);
+                json["type"] = "Unary";
+                json["op"] = magic_enum::enum_name(record.op);
+                json["operand"] = of(record.operand);
+                break;
+            }
+            case NodeKind::Multiary: {
+                const auto &record = ast.getMultiary(id_);
+                json["type"] = "Multiary";
+                json["op"] = magic_enum::enum_name(record.op);
+                json["object"] = of(record.object);
+                json["operands"] = ofList(record.operands);
+                break;
+            }
+            case NodeKind::Cast: {
+                const auto &record = ast.getCast(id_);
+                json["type"] = "Cast";
+                json["op"] = magic_enum::enum_name(record.op);
+                json["cast_type"] = of(record.type);
+                json["operand"] = of(record.operand);
+                break;
+            }
+            case NodeKind::Condition: {
+                const auto &record = ast.getCondition(id_);
+                json["type"] = "Condition";
+                json["condition"] = of(record.condition);
+                json["true_branch"] = of(record.trueBranch);
+                json["false_branch"] = of(record.falseBranch);
+                break;
+            }
+            case NodeKind::Member: {
+                const auto &record = ast.getMember(id_);
+                json["type"] = "Member";
+                json["object"] = of(record.object);
+                json["op"] = magic_enum::enum_name(record.op);
+                json["member"] = record.member;
+                break;
+            }
+            case NodeKind::If: {
+                const auto &record = ast.getIf(id_);
+                json["type"] = "If";
+                json["condition"] = of(record.condition);
+                json["then_stmt"] = of(record.thenStmt);
+                json["else_stmt"] = of(record.elseStmt);
+                break;
+            }
+            case NodeKind::While: {
+                const auto &record = ast.getWhile(id_);
+                json["type"] = "While";
+                json["condition"] = of(record.condition);
+                json["body"] = of(record.body);
+                break;
+            }
+            case NodeKind::For: {
+                const auto &record = ast.getFor(id_);
+                json["type"] = "For";
+                json["init"] = of(record.init);
+                json["condition"] = of(record.condition);
+                json["step"] = of(record.step);
+                json["body"] = of(record.body);
+                break;
+            }
+            case NodeKind::Return:
+                json["type"] = "Return";
+                json["value"] = of(ast.getReturn(id_).value);
+                break;
+            case NodeKind::Block:
+                json["type"] = "Block";
+                json["stmts"] = ofList(ast.getBlock(id_).stmts);
+                break;
+            case NodeKind::Break:
+                json["type"] = "Break";
+                break;
+            case NodeKind::Continue:
+                json["type"] = "Continue";
+                break;
+            case NodeKind::VariableDef: {
+                const auto &record = ast.getVariableDef(id_);
+                json["type"] = "VariableDef";
+                json["type_node"] = of(record.type);
+                json["name"] = record.name;
+                json["init"] = of(record.init);
+                break;
+            }
+            case NodeKind::FuncDef: {
+                const auto &record = ast.getFuncDef(id_);
+                json["type"] = "FuncDef";
+                json["return_type"] = of(record.returnType);
+                json["name"] = record.name;
+                json["params"] = ofList(record.params);
+                json["body"] = of(record.body);
+                break;
+            }
+            case NodeKind::StructDef: {
+                const auto &record = ast.getStructDef(id_);
+                json["type"] = "StructDef";
+                json["name"] = record.name;
+                json["fields"] = ofList(record.fields);
+                break;
+            }
+            case NodeKind::AliasDef: {
+                const auto &record = ast.getAliasDef(id_);
+                json["type"] = "AliasDef";
+                json["name"] = record.name;
+                json["type_node"] = of(record.type);
+                break;
+            }
+            case NodeKind::ExprStmt:
+                json["type"] = "ExprStmt";
+                json["expr"] = of(ast.getExprStmt(id_).expr);
+                break;
+            case NodeKind::EmptyStmt:
+                json["type"] = "EmptyStmt";
+                break;
+            case NodeKind::ASTRoot:
+                json["type"] = "ASTRoot";
+                json["children"] = Common::JSON::array();
+                for (auto stmt: ast.children())
+                    json["children"].push_back(of(stmt));
+                break;
+        }
+        return json;
+    }
+
+    FlatAST::FlatAST() { addNode(NodeKind::ASTRoot, ASTRootRecords_, ASTRootRecord{}, Common::Location()); }
+
+    FlatAST::FlatAST(const ASTRootPtr &root) : FlatAST() {
+        locations_[0] = root->location;
+        for (const auto &child: root->children)
+            append(child);
+        resources = root->resources;
+    }
+
+    NodeId FlatAST::append(const StmtNodePtr &stmt) {
+        auto id = add(stmt);
+        topLevel_.push_back(id);
+        return id;
+    }
+
+    ASTNodePtr FlatAST::child(NodeId id) const {
+        if (id == kNullNode)
+            return nullptr;
+        return node(id);
+    }
+
+    std::size_t FlatAST::memoryUsage() const {
+        std::size_t res = kinds_.capacity() * sizeof(NodeKind) + indices_.capacity() * sizeof(std::uint32_t) +
+                          locations_.capacity() * sizeof(Common::Location) +
+                          lists_.capacity() * sizeof(NodeId) + topLevel_.capacity() * sizeof(NodeId);
+#define REG_FLAT_MEMORY(Name, ...) res += Name##Records_.capacity() * sizeof(Name##Record);
+        TINY_COBALT_AST_NODES(REG_FLAT_MEMORY)
+#undef REG_FLAT_MEMORY
+        return res;
+    }
+
+    template<typename Record>
+    NodeId FlatAST::addNode(NodeKind kind, std::vector<Record> &records, Record record,
+                            const Common::Location &location) {
+        TINY_COBALT_ASSERT(kinds_.size() < kNullNode, "FlatAST: too many nodes");
+        auto id = static_cast<NodeId>(kinds_.size());
+        kinds_.push_back(kind);
+        indices_.push_back(static_cast<std::uint32_t>(records.size()));
+        records.push_back(std::move(record));
+        locations_.push_back(location);
+        return id;
+    }
+
+    template<typename Range>
+    FlatAST::List FlatAST::addList(const Range &nodes) {
+        // Children append their own lists, so collect the ids before appending this one.
+        std::vector<NodeId> ids;
+        ids.reserve(nodes.size());
+        for (const auto &node: nodes)
+            ids.push_back(add(node));
+        List list{static_cast<std::uint32_t>(lists_.size()), static_cast<std::uint32_t>(ids.size())};
+        lists_.insert(lists_.end(), ids.begin(), ids.end());
+        return list;
+    }
+
+    template<typename P>
+    NodeId FlatAST::add(const P &node) {
+        if constexpr (is_variant_v<P>) {
+            return std::visit([this](const auto &alt) { return add(alt); }, node);
+        } else {
+            if (!node)
+                return kNullNode;
+            // Records are built in braces, which evaluates the children in order, so ids follow the order of
+            // traverse() in post-order.
+            auto addDef = [this](const VariableDefNode &def) {
+                return addNode(NodeKind::VariableDef, VariableDefRecords_,
+                               VariableDefRecord{add(def.type), def.name, add(def.init)}, def.location);
+            };
+            auto matcher = Matcher{
+                    [&](SimpleTypePtr ptr) {
+                        return addNode(NodeKind::SimpleType, SimpleTypeRecords_, SimpleTypeRecord{ptr->name},
+                                       ptr->location);
+                    },
+                    [&](FuncTypePtr ptr) {
+                        return addNode(NodeKind::FuncType, FuncTypeRecords_,
+                                       FuncTypeRecord{add(ptr->returnType), addList(ptr->paramTypes)}, ptr->location);
+                    },
+                    [&](ComplexTypePtr ptr) {
+                        return addNode(NodeKind::ComplexType, ComplexTypeRecords_,
+                                       ComplexTypeRecord{ptr->templateName, addList(ptr->templateArgs)},
+                                       ptr->location);
+                    },
+                    [&](ConstExprPtr ptr) {
+                        return addNode(NodeKind::ConstExpr, ConstExprRecords_, ConstExprRecord{ptr->value, ptr->type},
+                                       ptr->location);
+                    },
+                    [&](VariablePtr ptr) {
+                        return addNode(NodeKind::Variable, VariableRecords_, VariableRecord{ptr->name},
+                                       ptr->location);
+                    },
+                    [&](BinaryPtr ptr) {
+                        return addNode(NodeKind::Binary, BinaryRecords_,
+                                       BinaryRecord{ptr->op, add(ptr->lhs), add(ptr->rhs)}, ptr->location);
+                    },
+                    [&](UnaryPtr ptr) {
+                        return addNode(NodeKind::Unary, UnaryRecords_, UnaryRecord{ptr->op, add(ptr->operand)},
+                                       ptr->location);
+                    },
+                    [&](MultiaryPtr ptr) {
+                        return addNode(NodeKind::Multiary, MultiaryRecords_,
+                                       MultiaryRecord{ptr->op, add(ptr->object), addList(ptr->operands)},
+                                       ptr->location);
+                    },
+                    [&](CastPtr ptr) {
+                        return addNode(NodeKind::Cast, CastRecords_,
+                                       CastRecord{ptr->op, add(ptr->type), add(ptr->operand)}, ptr->location);
+                    },
+                    [&](ConditionPtr ptr) {
+                        return addNode(
+                                NodeKind::Condition, ConditionRecords_,
+                                ConditionRecord{add(ptr->condition), add(ptr->trueBranch), add(ptr->falseBranch)},
+                                ptr->location);
+                    },
+                    [&](MemberPtr ptr) {
+                        return addNode(NodeKind::Member, MemberRecords_,
+                                       MemberRecord{ptr->op, add(ptr->object), ptr->member}, ptr->location);
+                    },
+                    [&](IfPtr ptr) {
+                        return addNode(NodeKind::If, IfRecords_,
+                                       IfRecord{add(ptr->condition), add(ptr->thenStmt), add(ptr->elseStmt)},
+                                       ptr->location);
+                    },
+                    [&](WhilePtr ptr) {
+                        return addNode(NodeKind::While, WhileRecords_,
+                                       WhileRecord{add(ptr->condition), add(ptr->body)}, ptr->location);
+                    },
+                    [&](ForPtr ptr) {
+                        return addNode(
+                                NodeKind::For, ForRecords_,
+                                ForRecord{add(ptr->init), add(ptr->condition), add(ptr->step), add(ptr->body)},
+                                ptr->location);
+                    },
+                    [&](ReturnPtr ptr) {
+                        return addNode(NodeKind::Return, ReturnRecords_, ReturnRecord{add(ptr->value)},
+                                       ptr->location);
+                    },
+                    [&](BlockPtr ptr) {
+                        return addNode(NodeKind::Block, BlockRecords_, BlockRecord{addList(ptr->stmts)},
+                                       ptr->location);
+                    },
+                    [&](BreakPtr ptr) {
+                        return addNode(NodeKind::Break, BreakRecords_, BreakRecord{}, ptr->location);
+                    },
+                    [&](ContinuePtr ptr) {
+                        return addNode(NodeKind::Continue, ContinueRecords_, ContinueRecord{}, ptr->location);
+                    },
+                    [&](VariableDefPtr ptr) { return addDef(*ptr); },
+                    [&](FuncDefNode::ParamsElem ptr) { return addDef(*ptr); },
+                    [&](StructDefNode::FieldsElem ptr) { return addDef(*ptr); },
+                    [&](FuncDefPtr ptr) {
+                        return addNode(NodeKind::FuncDef, FuncDefRecords_,
+                                       FuncDefRecord{add(ptr->returnType), ptr->name, addList(ptr->params),
+                                                     add(ptr->body)},
+                                       ptr->location);
+                    },
+                    [&](StructDefPtr ptr) {
+                        return addNode(NodeKind::StructDef, StructDefRecords_,
+                                       StructDefRecord{ptr->name, addList(ptr->fields)}, ptr->location);
+                    },
+                    [&](AliasDefPtr ptr) {
+                        return addNode(NodeKind::AliasDef, AliasDefRecords_,
+                                       AliasDefRecord{ptr->name, add(ptr->type)}, ptr->location);
+                    },
+                    [&](ExprStmtPtr ptr) {
+                        return addNode(NodeKind::ExprStmt, ExprStmtRecords_, ExprStmtRecord{add(ptr->expr)},
+                                       ptr->location);
+                    },
+                    [&](EmptyStmtPtr ptr) {
+                        return addNode(NodeKind::EmptyStmt, EmptyStmtRecords_, EmptyStmtRecord{}, ptr->location);
+                    },
+            };
+            ASTNodePtr ast = node;
+            auto res = kNullNode;
+            // A nested tree has no root, but keep the visit total.
+            if (!pointerType<ASTRootPtr>(ast))
+                res = visit(matcher, ast);
+            return res;
+        }
+    }
+
+} // namespace TinyCobalt::AST
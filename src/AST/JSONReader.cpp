@@ -0,0 +1,474 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "AST/JSONReader.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "AST/AST.h"
+#include "AST/NodeKind.h"
+#include "Common/Arena.h"
+#include "Common/Symbol.h"
+#include "Common/Utility.h"
+
+namespace TinyCobalt::AST {
+
+    namespace {
+        [[noreturn]] void malformed(const std::string &what) {
+            throw std::runtime_error("malformed AST JSON: " + what);
+        }
+
+        // Keys written by toJSON(), in sorted order.
+        enum class Field : std::uint8_t {
+            Body,
+            CastType,
+            Children,
+            Condition,
+            ElseStmt,
+            Expr,
+            ExprType,
+            FalseBranch,
+            Fields,
+            Init,
+            Lhs,
+            Member,
+            Name,
+            Object,
+            Op,
+            Operand,
+            Operands,
+            ParamTypes,
+            Params,
+            ReturnType,
+            Rhs,
+            Step,
+            Stmts,
+            TemplateArgs,
+            TemplateName,
+            ThenStmt,
+            TrueBranch,
+            Type,
+            TypeNode,
+            Value,
+        };
+
+        constexpr std::array<std::string_view, 30> kKeys{
+                "body", "cast_type", "children", "condition", "else_stmt", "expr", "expr_type", "false_branch",
+                "fields", "init", "lhs", "member", "name", "object", "op", "operand", "operands", "param_types",
+                "params", "return_type", "rhs", "step", "stmts", "template_args", "template_name", "then_stmt",
+                "true_branch", "type", "type_node", "value",
+        };
+        static_assert(kKeys.size() == static_cast<std::size_t>(Field::Value) + 1, "A key is missing.");
+        static_assert(std::ranges::is_sorted(kKeys), "kKeys must be sorted for the binary search.");
+
+        Field field(std::string_view key) {
+            auto it = std::ranges::lower_bound(kKeys, key);
+            if (it == kKeys.end() || *it != key)
+                malformed("unknown key \"" + std::string(key) + "\"");
+            return static_cast<Field>(it - kKeys.begin());
+        }
+
+        std::string quoted(Field key) { return '"' + std::string(kKeys[static_cast<std::size_t>(key)]) + '"'; }
+
+        // A value read for a key: absent, null, a string or a node that has been built. Parameters and fields are
+        // kept apart from other variable definitions because they have node types of their own.
+        using Slot = std::variant<std::monostate, std::nullptr_t, std::string, TypeNodePtr, ConstExprPtr, ExprNodePtr,
+                                  StmtNodePtr, FuncDefNode::ParamsElem, StructDefNode::FieldsElem>;
+
+        // An object being read. Every node has at most one list, so one is kept per object.
+        struct Frame {
+            std::array<Slot, kKeys.size()> fields;
+            std::vector<Slot> list;
+            Field key = Field::Type;
+            Field listKey = Field::Type;
+            bool inList = false;
+            bool hasList = false;
+
+            void reset() {
+                std::ranges::fill(fields, Slot{});
+                list.clear();
+                inList = hasList = false;
+            }
+
+            Slot &operator[](Field name) { return fields[static_cast<std::size_t>(name)]; }
+        };
+
+        class Handler final : public nlohmann::json_sax<Common::JSON> {
+        public:
+            bool null() override { return put(nullptr); }
+            bool boolean(bool) override { malformed("unexpected boolean"); }
+            bool number_integer(number_integer_t) override { malformed("unexpected number"); }
+            bool number_unsigned(number_unsigned_t) override { malformed("unexpected number"); }
+            bool number_float(number_float_t, const string_t &) override { malformed("unexpected number"); }
+            bool string(string_t &val) override { return put(std::move(val)); }
+            bool binary(binary_t &) override { malformed("unexpected binary value"); }
+
+            bool start_object(std::size_t) override {
+                // Frames are reused, so that their lists keep their capacity.
+                if (depth_ == frames_.size())
+                    frames_.emplace_back();
+                else
+                    frames_[depth_].reset();
+                ++depth_;
+                return true;
+            }
+
+            bool key(string_t &val) override {
+                auto &frame = top();
+                frame.key = field(val);
+                if (!std::holds_alternative<std::monostate>(frame[frame.key]) ||
+                    (frame.hasList && frame.listKey == frame.key))
+                    malformed("duplicate key " + quoted(frame.key));
+                return true;
+            }
+
+            bool end_object() override {
+                auto &frame = top();
+                // Variable definitions depend on the list they are in.
+                std::optional<Field> context;
+                if (depth_ >= 2 && frames_[depth_ - 2].inList)
+                    context = frames_[depth_ - 2].listKey;
+                if (depth_ == 1) {
+                    root_ = root(frame);
+                    --depth_;
+                    return true;
+                }
+                auto node = build(frame, context);
+                --depth_;
+                return put(std::move(node));
+            }
+
+            bool start_array(std::size_t) override {
+                auto &frame = top();
+                if (frame.inList)
+                    malformed("nested array in " + quoted(frame.key));
+                if (frame.hasList)
+                    malformed("more than one array in an object");
+                frame.inList = frame.hasList = true;
+                frame.listKey = frame.key;
+                frame.list.clear();
+                return true;
+            }
+
+            bool end_array() override {
+                top().inList = false;
+                return true;
+            }
+
+            bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &ex) override {
+                malformed(ex.what());
+            }
+
+            ASTRootPtr result() {
+                if (!root_)
+                    malformed("no tree");
+                root_->resources.emplace_back(std::move(pool_));
+                root_->resources.emplace_back(std::move(arena_));
+                return std::move(root_);
+            }
+
+        private:
+            Frame &top() {
+                if (depth_ == 0)
+                    malformed("expected an object");
+                return frames_[depth_ - 1];
+            }
+
+            bool put(Slot value) {
+                auto &frame = top();
+                if (frame.inList)
+                    frame.list.push_back(std::move(value));
+                else
+                    frame[frame.key] = std::move(value);
+                return true;
+            }
+
+            // Allocate a node like YaccDriver::allocNode does. The root owns the arena, so it is on the heap.
+            template<typename T, typename... Args>
+            std::shared_ptr<T> make(Args &&...args) {
+                return std::allocate_shared<T>(Common::SharedArenaAllocator<T>(arena_), std::forward<Args>(args)...);
+            }
+
+            template<typename P, typename T>
+            static Slot wrap(std::shared_ptr<T> node) {
+                return Slot(std::in_place_type<P>, std::move(node));
+            }
+
+            static Slot &slot(Frame &frame, Field key) {
+                auto &value = frame[key];
+                if (std::holds_alternative<std::monostate>(value))
+                    malformed("missing key " + quoted(key));
+                return value;
+            }
+
+            template<typename T>
+            static T as(Slot &value, Field key) {
+                if constexpr (is_variant_v<T>) {
+                    if (auto *type = std::get_if<TypeNodePtr>(&value))
+                        return T(std::in_place_type<TypeNodePtr>, std::move(*type));
+                    if (auto *constant = std::get_if<ConstExprPtr>(&value))
+                        return T(std::in_place_type<ConstExprPtr>, std::move(*constant));
+                } else {
+                    if (std::holds_alternative<std::nullptr_t>(value))
+                        return nullptr;
+                    if (auto *node = std::get_if<T>(&value))
+                        return std::move(*node);
+                    if constexpr (std::is_same_v<T, ExprNodePtr>)
+                        if (auto *constant = std::get_if<ConstExprPtr>(&value))
+                            return ExprNodePtr(std::move(*constant));
+                }
+                malformed("unexpected value of " + quoted(key));
+            }
+
+            template<typename T>
+            static T take(Frame &frame, Field key) {
+                return as<T>(slot(frame, key), key);
+            }
+
+            template<typename T>
+            static std::vector<T> takeList(Frame &frame, Field key) {
+                if (!frame.hasList || frame.listKey != key)
+                    malformed("missing array " + quoted(key));
+                std::vector<T> res;
+                res.reserve(frame.list.size());
+                for (auto &value: frame.list)
+                    res.push_back(as<T>(value, key));
+                return res;
+            }
+
+            static const std::string &text(Frame &frame, Field key) {
+                auto *text = std::get_if<std::string>(&slot(frame, key));
+                if (!text)
+                    malformed("expected a string for " + quoted(key));
+                return *text;
+            }
+
+            Common::Symbol symbol(Frame &frame, Field key) { return pool_->intern(text(frame, key)); }
+
+            template<typename E>
+            static E enumValue(Frame &frame, Field key) {
+                const auto &name = text(frame, key);
+                auto value = magic_enum::enum_cast<E>(name);
+                if (!value)
+                    malformed("unknown " + std::string(magic_enum::enum_type_name<E>()) + " \"" + name + "\"");
+                return *value;
+            }
+
+            ConstExprPtr constExpr(Frame &frame) {
+                auto type = enumValue<ConstExprType>(frame, Field::ExprType);
+                const auto &value = text(frame, Field::Value);
+                if (type == ConstExprType::String)
+                    return make<ConstExprNode>(type, pool_->intern(value));
+                try {
+                    return make<ConstExprNode>(type, ConstExprNode::decode(value, type));
+                } catch (const std::logic_error &e) {
+                    malformed(e.what());
+                }
+            }
+
+            template<typename P, typename T>
+            Slot variableDef(Frame &frame) {
+                auto type = take<TypeNodePtr>(frame, Field::TypeNode);
+                auto name = symbol(frame, Field::Name);
+                auto init = take<ExprNodePtr>(frame, Field::Init);
+                return wrap<P>(make<T>(std::move(type), name, std::move(init)));
+            }
+
+            ASTRootPtr root(Frame &frame) {
+                auto *tag = std::get_if<std::string>(&frame[Field::Type]);
+                if (!tag || *tag != "ASTRoot")
+                    malformed("the top-level object is not an ASTRoot");
+                return std::make_shared<ASTRootNode>(takeList<StmtNodePtr>(frame, Field::Children));
+            }
+
+            // Arguments are taken into locals first, so that errors are reported in the order of the keys.
+            Slot build(Frame &frame, std::optional<Field> context) {
+                auto kind = magic_enum::enum_cast<NodeKind>(text(frame, Field::Type));
+                if (!kind)
+                    malformed("unknown node type \"" + text(frame, Field::Type) + "\"");
+                switch (*kind) {
+                    case NodeKind::SimpleType:
+                        return wrap<TypeNodePtr>(make<SimpleTypeNode>(symbol(frame, Field::Name)));
+                    case NodeKind::FuncType: {
+                        auto ret = take<TypeNodePtr>(frame, Field::ReturnType);
+                        auto params = takeList<TypeNodePtr>(frame, Field::ParamTypes);
+                        return wrap<TypeNodePtr>(make<FuncTypeNode>(std::move(ret), std::move(params)));
+                    }
+                    case NodeKind::ComplexType: {
+                        auto name = symbol(frame, Field::TemplateName);
+                        auto args = takeList<ComplexTypeNode::TemplateArgType>(frame, Field::TemplateArgs);
+                        return wrap<TypeNodePtr>(make<ComplexTypeNode>(name, std::move(args)));
+                    }
+                    case NodeKind::ConstExpr:
+                        return wrap<ConstExprPtr>(constExpr(frame));
+                    case NodeKind::Variable:
+                        return wrap<ExprNodePtr>(make<VariableNode>(symbol(frame, Field::Name)));
+                    case NodeKind::Binary: {
+                        auto lhs = take<ExprNodePtr>(frame, Field::Lhs);
+                        auto op = enumValue<BinaryOp>(frame, Field::Op);
+                        auto rhs = take<ExprNodePtr>(frame, Field::Rhs);
+                        return wrap<ExprNodePtr>(make<BinaryNode>(std::move(lhs), op, std::move(rhs)));
+                    }
+                    case NodeKind::Unary: {
+                        auto op = enumValue<UnaryOp>(frame, Field::Op);
+                        auto operand = take<ExprNodePtr>(frame, Field::Operand);
+                        return wrap<ExprNodePtr>(make<UnaryNode>(op, std::move(operand)));
+                    }
+                    case NodeKind::Multiary: {
+                        auto object = take<ExprNodePtr>(frame, Field::Object);
+                        auto op = enumValue<MultiaryOp>(frame, Field::Op);
+                        auto operands = takeList<ExprNodePtr>(frame, Field::Operands);
+                        return wrap<ExprNodePtr>(make<MultiaryNode>(op, std::move(object), std::move(operands)));
+                    }
+                    case NodeKind::Cast: {
+                        auto cast_type = take<TypeNodePtr>(frame, Field::CastType);
+                        auto op = enumValue<CastType>(frame, Field::Op);
+                        auto operand = take<ExprNodePtr>(frame, Field::Operand);
+                        return wrap<ExprNodePtr>(make<CastNode>(op, std::move(cast_type), std::move(operand)));
+                    }
+                    case NodeKind::Condition: {
+                        auto condition = take<ExprNodePtr>(frame, Field::Condition);
+                        auto false_branch = take<ExprNodePtr>(frame, Field::FalseBranch);
+                        auto true_branch = take<ExprNodePtr>(frame, Field::TrueBranch);
+                        return wrap<ExprNodePtr>(make<ConditionNode>(std::move(condition), std::move(true_branch),
+                                                                     std::move(false_branch)));
+                    }
+                    case NodeKind::Member: {
+                        auto member = symbol(frame, Field::Member);
+                        auto object = take<ExprNodePtr>(frame, Field::Object);
+                        auto op = enumValue<BinaryOp>(frame, Field::Op);
+                        return wrap<ExprNodePtr>(make<MemberNode>(std::move(object), op, member));
+                    }
+                    case NodeKind::If: {
+                        auto condition = take<ExprNodePtr>(frame, Field::Condition);
+                        auto else_stmt = take<StmtNodePtr>(frame, Field::ElseStmt);
+                        auto then_stmt = take<StmtNodePtr>(frame, Field::ThenStmt);
+                        return wrap<StmtNodePtr>(
+                                make<IfNode>(std::move(condition), std::move(then_stmt), std::move(else_stmt)));
+                    }
+                    case NodeKind::While: {
+                        auto body = take<StmtNodePtr>(frame, Field::Body);
+                        auto condition = take<ExprNodePtr>(frame, Field::Condition);
+                        return wrap<StmtNodePtr>(make<WhileNode>(std::move(condition), std::move(body)));
+                    }
+                    case NodeKind::For: {
+                        auto body = take<StmtNodePtr>(frame, Field::Body);
+                        auto condition = take<ExprNodePtr>(frame, Field::Condition);
+                        auto init = take<ExprNodePtr>(frame, Field::Init);
+                        auto step = take<ExprNodePtr>(frame, Field::Step);
+                        return wrap<StmtNodePtr>(
+                                make<ForNode>(std::move(init), std::move(condition), std::move(step), std::move(body)));
+                    }
+                    case NodeKind::Return:
+                        return wrap<StmtNodePtr>(make<ReturnNode>(take<ExprNodePtr>(frame, Field::Value)));
+                    case NodeKind::Block:
+                        return wrap<StmtNodePtr>(make<BlockNode>(takeList<StmtNodePtr>(frame, Field::Stmts)));
+                    case NodeKind::Break:
+                        return wrap<StmtNodePtr>(make<BreakNode>());
+                    case NodeKind::Continue:
+                        return wrap<StmtNodePtr>(make<ContinueNode>());
+                    case NodeKind::VariableDef:
+                        if (context == Field::Params)
+                            return variableDef<FuncDefNode::ParamsElem, FuncDefNode::ParamsElemNode>(frame);
+                        if (context == Field::Fields)
+                            return variableDef<StructDefNode::FieldsElem, StructDefNode::FieldsElemNode>(frame);
+                        return variableDef<StmtNodePtr, VariableDefNode>(frame);
+                    case NodeKind::FuncDef: {
+                        auto body = take<StmtNodePtr>(frame, Field::Body);
+                        auto name = symbol(frame, Field::Name);
+                        auto params = takeList<FuncDefNode::ParamsElem>(frame, Field::Params);
+                        auto ret = take<TypeNodePtr>(frame, Field::ReturnType);
+                        return wrap<StmtNodePtr>(
+                                make<FuncDefNode>(std::move(ret), name, std::move(params), std::move(body)));
+                    }
+                    case NodeKind::StructDef: {
+                        auto fields = takeList<StructDefNode::FieldsElem>(frame, Field::Fields);
+                        auto name = symbol(frame, Field::Name);
+                        return wrap<StmtNodePtr>(make<StructDefNode>(name, std::move(fields)));
+                    }
+                    case NodeKind::ExprStmt:
+                        return wrap<StmtNodePtr>(make<ExprStmtNode>(take<ExprNodePtr>(frame, Field::Expr)));
+                    case NodeKind::EmptyStmt:
+                        return wrap<StmtNodePtr>(make<EmptyStmtNode>());
+                    case NodeKind::AliasDef: {
+                        auto name = symbol(frame, Field::Name);
+                        auto type = take<TypeNodePtr>(frame, Field::TypeNode);
+                        return wrap<StmtNodePtr>(make<AliasDefNode>(name, std::move(type)));
+                    }
+                    case NodeKind::ASTRoot:
+                        break;
+                }
+                malformed("unexpected " + std::string(magic_enum::enum_name(*kind)) + " node");
+            }
+
+            std::vector<Frame> frames_;
+            std::size_t depth_ = 0;
+            ASTRootPtr root_;
+            std::shared_ptr<Common::StringPool> pool_ = std::make_shared<Common::StringPool>();
+            std::shared_ptr<Common::Arena> arena_ = Common::makeArena(pool_);
+        };
+
+        // Feed a parsed document to the handler as if it were being read.
+        void replay(const Common::JSON &json, Handler &handler) {
+            switch (json.type()) {
+                case Common::JSON::value_t::object:
+                    handler.start_object(json.size());
+                    for (const auto &[name, value]: json.get_ref<const Common::JSON::object_t &>()) {
+                        auto key = name;
+                        handler.key(key);
+                        replay(value, handler);
+                    }
+                    handler.end_object();
+                    break;
+                case Common::JSON::value_t::array:
+                    handler.start_array(json.size());
+                    for (const auto &value: json)
+                        replay(value, handler);
+                    handler.end_array();
+                    break;
+                case Common::JSON::value_t::string: {
+                    auto value = json.get<std::string>();
+                    handler.string(value);
+                    break;
+                }
+                case Common::JSON::value_t::null:
+                    handler.null();
+                    break;
+                default:
+                    malformed(std::string("unexpected ") + json.type_name());
+            }
+        }
+    } // namespace
+
+    ASTRootPtr JSONReader::read(std::istream &is) {
+        Handler handler;
+        Common::JSON::sax_parse(is, &handler);
+        return handler.result();
+    }
+
+    ASTRootPtr JSONReader::read(std::string_view text) {
+        Handler handler;
+        Common::JSON::sax_parse(text.begin(), text.end(), &handler);
+        return handler.result();
+    }
+
+} // namespace TinyCobalt::AST
+
+namespace TinyCobalt::Common {
+    template<>
+    AST::ASTRootPtr fromJSON<AST::ASTRootPtr>(const JSON &obj) {
+        AST::Handler handler;
+        AST::replay(obj, handler);
+        return handler.result();
+    }
+} // namespace TinyCobalt::Common
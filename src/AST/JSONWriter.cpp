@@ -0,0 +1,278 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "AST/JSONWriter.h"
+#include <cstddef>
+#include <variant>
+#include "AST/AST.h"
+#include "Common/Utility.h"
+
+namespace TinyCobalt::AST {
+
+    JSONWriter &JSONWriter::write(const ASTNodePtr &node) {
+        value(node);
+        return *this;
+    }
+
+    // Escapes the same characters as nlohmann::json::dump().
+    void JSONWriter::string(std::string_view text) {
+        static constexpr char kHex[] = "0123456789abcdef";
+        os_.put('"');
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            auto ch = static_cast<unsigned char>(text[i]);
+            if (ch >= 0x20 && ch != '"' && ch != '\\')
+                continue;
+            os_.write(text.data() + begin, static_cast<std::streamsize>(i - begin));
+            begin = i + 1;
+            switch (ch) {
+                case '"':
+                    os_ << "\\\"";
+                    break;
+                case '\\':
+                    os_ << "\\\\";
+                    break;
+                case '\b':
+                    os_ << "\\b";
+                    break;
+                case '\f':
+                    os_ << "\\f";
+                    break;
+                case '\n':
+                    os_ << "\\n";
+                    break;
+                case '\r':
+                    os_ << "\\r";
+                    break;
+                case '\t':
+                    os_ << "\\t";
+                    break;
+                default:
+                    os_ << "\\u00" << kHex[ch >> 4] << kHex[ch & 0xf];
+                    break;
+            }
+        }
+        os_.write(text.data() + begin, static_cast<std::streamsize>(text.size() - begin));
+        os_.put('"');
+    }
+
+    void JSONWriter::key(std::string_view name, bool first) {
+        os_.put(first ? '{' : ',');
+        string(name);
+        os_.put(':');
+    }
+
+    template<typename L>
+    void JSONWriter::list(const L &nodes) {
+        os_.put('[');
+        bool first = true;
+        for (const auto &node: nodes) {
+            if (!first)
+                os_.put(',');
+            first = false;
+            value(node);
+        }
+        os_.put(']');
+    }
+
+    // Each object lists its keys in sorted order, which is how nlohmann::json stores them.
+    template<typename P>
+    void JSONWriter::value(const P &node) {
+        if constexpr (is_variant_v<P>) {
+            std::visit([this](const auto &alt) { value(alt); }, node);
+        } else {
+            if (!node) {
+                os_ << "null";
+                return;
+            }
+            // Every node struct has a type key, so a node the matcher knows sets matched.
+            bool matched = false;
+            auto type = [this, &matched](std::string_view name, bool first = false) {
+                matched = true;
+                key("type", first);
+                string(name);
+            };
+            auto def = [&](const VariableDefNode &field) {
+                key("init", true);
+                value(field.init);
+                key("name");
+                string(field.name.view());
+                type("VariableDef");
+                key("type_node");
+                value(field.type);
+            };
+            auto matcher = Matcher{
+                    [&](SimpleTypePtr ptr) {
+                        key("name", true);
+                        string(ptr->name.view());
+                        type("SimpleType");
+                    },
+                    [&](FuncTypePtr ptr) {
+                        key("param_types", true);
+                        list(ptr->paramTypes);
+                        key("return_type");
+                        value(ptr->returnType);
+                        type("FuncType");
+                    },
+                    [&](ComplexTypePtr ptr) {
+                        key("template_args", true);
+                        list(ptr->templateArgs);
+                        key("template_name");
+                        string(ptr->templateName.view());
+                        type("ComplexType");
+                    },
+                    [&](ConstExprPtr ptr) {
+                        key("expr_type", true);
+                        string(magic_enum::enum_name(ptr->type));
+                        type("ConstExpr");
+                        key("value");
+                        string(ptr->text());
+                    },
+                    [&](VariablePtr ptr) {
+                        key("name", true);
+                        string(ptr->name.view());
+                        type("Variable");
+                    },
+                    [&](BinaryPtr ptr) {
+                        key("lhs", true);
+                        value(ptr->lhs);
+                        key("op");
+                        string(magic_enum::enum_name(ptr->op));
+                        key("rhs");
+                        value(ptr->rhs);
+                        type("Binary");
+                    },
+                    [&](UnaryPtr ptr) {
+                        key("op", true);
+                        string(magic_enum::enum_name(ptr->op));
+                        key("operand");
+                        value(ptr->operand);
+                        type("Unary");
+                    },
+                    [&](MultiaryPtr ptr) {
+                        key("object", true);
+                        value(ptr->object);
+                        key("op");
+                        string(magic_enum::enum_name(ptr->op));
+                        key("operands");
+                        list(ptr->operands);
+                        type("Multiary");
+                    },
+                    [&](CastPtr ptr) {
+                        key("cast_type", true);
+                        value(ptr->type);
+                        key("op");
+                        string(magic_enum::enum_name(ptr->op));
+                        key("operand");
+                        value(ptr->operand);
+                        type("Cast");
+                    },
+                    [&](ConditionPtr ptr) {
+                        key("condition", true);
+                        value(ptr->condition);
+                        key("false_branch");
+                        value(ptr->falseBranch);
+                        key("true_branch");
+                        value(ptr->trueBranch);
+                        type("Condition");
+                    },
+                    [&](MemberPtr ptr) {
+                        key("member", true);
+                        string(ptr->member.view());
+                        key("object");
+                        value(ptr->object);
+                        key("op");
+                        string(magic_enum::enum_name(ptr->op));
+                        type("Member");
+                    },
+                    [&](IfPtr ptr) {
+                        key("condition", true);
+                        value(ptr->condition);
+                        key("else_stmt");
+                        value(ptr->elseStmt);
+                        key("then_stmt");
+                        value(ptr->thenStmt);
+                        type("If");
+                    },
+                    [&](WhilePtr ptr) {
+                        key("body", true);
+                        value(ptr->body);
+                        key("condition");
+                        value(ptr->condition);
+                        type("While");
+                    },
+                    [&](ForPtr ptr) {
+                        key("body", true);
+                        value(ptr->body);
+                        key("condition");
+                        value(ptr->condition);
+                        key("init");
+                        value(ptr->init);
+                        key("step");
+                        value(ptr->step);
+                        type("For");
+                    },
+                    [&](ReturnPtr ptr) {
+                        type("Return", true);
+                        key("value");
+                        value(ptr->value);
+                    },
+                    [&](BlockPtr ptr) {
+                        key("stmts", true);
+                        list(ptr->stmts);
+                        type("Block");
+                    },
+                    [&](BreakPtr) { type("Break", true); },
+                    [&](ContinuePtr) { type("Continue", true); },
+                    [&](VariableDefPtr ptr) { def(*ptr); },
+                    [&](FuncDefNode::ParamsElem ptr) { def(*ptr); },
+                    [&](StructDefNode::FieldsElem ptr) { def(*ptr); },
+                    [&](FuncDefPtr ptr) {
+                        key("body", true);
+                        value(ptr->body);
+                        key("name");
+                        string(ptr->name.view());
+                        key("params");
+                        list(ptr->params);
+                        key("return_type");
+                        value(ptr->returnType);
+                        type("FuncDef");
+                    },
+                    [&](StructDefPtr ptr) {
+                        key("fields", true);
+                        list(ptr->fields);
+                        key("name");
+                        string(ptr->name.view());
+                        type("StructDef");
+                    },
+                    [&](AliasDefPtr ptr) {
+                        key("name", true);
+                        string(ptr->name.view());
+                        type("AliasDef");
+                        key("type_node");
+                        value(ptr->type);
+                    },
+                    [&](ExprStmtPtr ptr) {
+                        key("expr", true);
+                        value(ptr->expr);
+                        type("ExprStmt");
+                    },
+                    [&](EmptyStmtPtr) { type("EmptyStmt", true); },
+                    [&](ASTRootPtr ptr) {
+                        key("children", true);
+                        list(ptr->children);
+                        type("ASTRoot");
+                    },
+            };
+            ASTNodePtr ast = node;
+            visit(matcher, ast);
+            // Other nodes, e.g. those of a FlatAST, are written through their toJSON(), which gives the same output.
+            if (matched)
+                os_.put('}');
+            else
+                os_ << ast->toJSON().dump();
+        }
+    }
+
+} // namespace TinyCobalt::AST
@@ -2,4 +2,81 @@
 // Created by Renatus Madrigal on 01/12/2025
 //
 
-int main(int argc, char *argv[]) { return 0; }
\ No newline at end of file
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include "AST/JSONWriter.h"
+#include "LexerParser/ParallelParse.h"
+#include "LexerParser/SourceManager.h"
+
+namespace {
+    int usage(const char *program) {
+        std::cerr << "Usage: " << program << " [-j jobs] [--dump-ast] files..." << std::endl;
+        return 1;
+    }
+
+    // The number of jobs given to -j, or nothing if it is not a number.
+    std::optional<std::size_t> parseJobs(std::string_view text) {
+        std::size_t jobs = 0;
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), jobs);
+        if (text.empty() || error != std::errc{} || end != text.data() + text.size())
+            return std::nullopt;
+        return jobs;
+    }
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::size_t jobs = 0;
+    bool dump_ast = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "-j") {
+            auto value = ++i == argc ? std::nullopt : parseJobs(argv[i]);
+            if (!value)
+                return usage(argv[0]);
+            jobs = *value;
+        } else if (arg == "--dump-ast") {
+            dump_ast = true;
+        } else if (arg.starts_with("-j")) {
+            auto value = parseJobs(arg.substr(2));
+            if (!value)
+                return usage(argv[0]);
+            jobs = *value;
+        } else {
+            files.emplace_back(arg);
+        }
+    }
+    if (files.empty())
+        return usage(argv[0]);
+
+    // Shared by all files, so that the locations of every diagnostic can be described.
+    auto sources = std::make_shared<TinyCobalt::LexerParser::SourceManager>();
+    int status = 0;
+    for (const auto &result: TinyCobalt::LexerParser::parseFiles(files, sources, jobs)) {
+        if (result.error == 0) {
+            // One JSON document per line, written without building it in memory.
+            if (dump_ast) {
+                TinyCobalt::AST::JSONWriter(std::cout).write(result.root);
+                std::cout << '\n';
+            }
+            continue;
+        }
+        status = 1;
+        if (!result.message.empty()) {
+            std::cerr << result.file << ": " << result.message << std::endl;
+        } else if (!result.diagnostics.empty()) {
+            for (const auto &diagnostic: result.diagnostics)
+                std::cerr << sources->format(diagnostic.location) << ": " << diagnostic.message << std::endl;
+        } else {
+            std::cerr << result.file << ": parse failed" << std::endl;
+        }
+    }
+    return status;
+}
@@ -0,0 +1,302 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "DirectLexer.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "Keywords.h"
+#include "Literals.h"
+#include "LexerParser/YaccDriver.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TINY_COBALT_LEXER_SSE2 1
+#else
+#define TINY_COBALT_LEXER_SSE2 0
+#endif
+
+namespace TinyCobalt::LexerParser {
+    namespace {
+        enum CharClass : std::uint8_t {
+            kBlank = 1 << 0, // [ \t\r\n]
+            kDigit = 1 << 1, // [0-9]
+            kIdent = 1 << 2, // [a-zA-Z_0-9]
+        };
+
+        constexpr std::array<std::uint8_t, 256> kCharClass = [] {
+            std::array<std::uint8_t, 256> table{};
+            table[' '] = table['\t'] = table['\r'] = table['\n'] = kBlank;
+            for (int c = '0'; c <= '9'; ++c)
+                table[c] = kDigit | kIdent;
+            for (int c = 'a'; c <= 'z'; ++c)
+                table[c] = kIdent;
+            for (int c = 'A'; c <= 'Z'; ++c)
+                table[c] = kIdent;
+            table['_'] = kIdent;
+            return table;
+        }();
+
+        inline bool is(char c, std::uint8_t cls) { return kCharClass[static_cast<unsigned char>(c)] & cls; }
+
+#if TINY_COBALT_LEXER_SSE2
+        // Bit i of the result is set when byte i of the block lies in [lo, hi]. Only valid for ASCII bounds, bytes
+        // above 0x7f compare as negative and never match.
+        inline __m128i inRange(__m128i block, char lo, char hi) {
+            return _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                                 _mm_cmplt_epi8(block, _mm_set1_epi8(static_cast<char>(hi + 1))));
+        }
+
+        inline __m128i equals(__m128i block, char c) { return _mm_cmpeq_epi8(block, _mm_set1_epi8(c)); }
+
+        inline unsigned blockMask(__m128i block, std::uint8_t cls) {
+            __m128i mask = _mm_setzero_si128();
+            if (cls & kBlank)
+                mask = _mm_or_si128(mask, _mm_or_si128(_mm_or_si128(equals(block, ' '), equals(block, '\n')),
+                                                       _mm_or_si128(equals(block, '\t'), equals(block, '\r'))));
+            if (cls & kIdent)
+                mask = _mm_or_si128(mask, _mm_or_si128(_mm_or_si128(inRange(block, 'a', 'z'), inRange(block, 'A', 'Z')),
+                                                       equals(block, '_')));
+            if (cls & (kDigit | kIdent))
+                mask = _mm_or_si128(mask, inRange(block, '0', '9'));
+            return static_cast<unsigned>(_mm_movemask_epi8(mask));
+        }
+#endif
+
+        /**
+         * Skip the longest run of characters of the given class starting at p.
+         */
+        template<std::uint8_t kClass>
+        inline const char *skipRun(const char *p, const char *end) {
+#if TINY_COBALT_LEXER_SSE2
+            while (end - p >= 16) {
+                auto mask = blockMask(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), kClass);
+                if (mask != 0xFFFFu)
+                    return p + std::countr_one(mask);
+                p += 16;
+            }
+#endif
+            while (p != end && is(*p, kClass))
+                ++p;
+            return p;
+        }
+
+        inline const char *skipHexDigits(const char *p, const char *end) {
+            while (p != end && (is(*p, kDigit) || (*p >= 'a' && *p <= 'f') || (*p >= 'A' && *p <= 'F')))
+                ++p;
+            return p;
+        }
+
+        inline const char *skipDigitsIn(const char *p, const char *end, char hi) {
+            while (p != end && *p >= '0' && *p <= hi)
+                ++p;
+            return p;
+        }
+
+        using YYParser = yy::parser;
+        using Kind = YYParser::token::token_kind_type;
+    } // namespace
+
+    yy::parser::symbol_type DirectLexer::yylex(YaccDriver &driver) {
+        auto &loc = driver.location;
+        loc.step();
+        while (true) {
+            if (cursor_ == end_)
+                return YYParser::make_YYEOF(loc);
+            const char *start = cursor_;
+            // Consume len characters of the current token, mirroring YY_USER_ACTION in Lexer.ll.
+            auto take = [&](std::ptrdiff_t len) {
+                cursor_ += len;
+                loc.columns(static_cast<int>(len));
+            };
+            auto peek = [&](std::ptrdiff_t offset) -> char { return end_ - cursor_ > offset ? cursor_[offset] : '\0'; };
+
+            switch (*cursor_) {
+                case ' ':
+                case '\t':
+                case '\r':
+                case '\n':
+                    take(skipRun<kBlank>(cursor_ + 1, end_) - start);
+                    loc.step();
+                    continue;
+                case '-':
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_SUBASSIGN(loc);
+                    if (peek(1) == '-')
+                        return take(2), YYParser::make_DEC(loc);
+                    if (peek(1) == '>')
+                        return take(2), YYParser::make_POINTER(loc);
+                    return take(1), YYParser::make_MINUS(loc);
+                case '+':
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_ADDASSIGN(loc);
+                    if (peek(1) == '+')
+                        return take(2), YYParser::make_INC(loc);
+                    return take(1), YYParser::make_PLUS(loc);
+                case '*':
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_MULASSIGN(loc);
+                    return take(1), YYParser::make_TIMES(loc);
+                case '/':
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_DIVASSIGN(loc);
+                    return take(1), YYParser::make_DIVIDE(loc);
+                case '%':
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_MODASSIGN(loc);
+                    return take(1), YYParser::make_MODULO(loc);
+                case '&':
+                    if (peek(1) == '&')
+                        return take(2), YYParser::make_AND(loc);
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_ANDASSIGN(loc);
+                    return take(1), YYParser::make_BITAND(loc);
+                case '|':
+                    if (peek(1) == '|')
+                        return take(2), YYParser::make_OR(loc);
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_ORASSIGN(loc);
+                    return take(1), YYParser::make_BITOR(loc);
+                case '^':
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_XORASSIGN(loc);
+                    return take(1), YYParser::make_BITXOR(loc);
+                case '~':
+                    return take(1), YYParser::make_BITNOT(loc);
+                case '<':
+                    if (peek(1) == '<')
+                        return peek(2) == '=' ? (take(3), YYParser::make_LSHIFTASSIGN(loc))
+                                              : (take(2), YYParser::make_LSHIFT(loc));
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_LEQ(loc);
+                    return take(1), YYParser::make_LESS(loc);
+                case '>':
+                    if (peek(1) == '>')
+                        return peek(2) == '=' ? (take(3), YYParser::make_RSHIFTASSIGN(loc))
+                                              : (take(2), YYParser::make_RSHIFT(loc));
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_GEQ(loc);
+                    return take(1), YYParser::make_GREATER(loc);
+                case '!':
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_NE(loc);
+                    return take(1), YYParser::make_NOT(loc);
+                case '=':
+                    if (peek(1) == '=')
+                        return take(2), YYParser::make_EQ(loc);
+                    return take(1), YYParser::make_ASSIGN(loc);
+                case '.':
+                    if (is(peek(1), kDigit))
+                        return lexNumber(driver);
+                    return take(1), YYParser::make_MEMBER(loc);
+                case '(':
+                    return take(1), YYParser::make_LPAREN(loc);
+                case ')':
+                    return take(1), YYParser::make_RPAREN(loc);
+                case '[':
+                    return take(1), YYParser::make_LBRACKET(loc);
+                case ']':
+                    return take(1), YYParser::make_RBRACKET(loc);
+                case '{':
+                    return take(1), YYParser::make_LBRACE(loc);
+                case '}':
+                    return take(1), YYParser::make_RBRACE(loc);
+                case ',':
+                    return take(1), YYParser::make_COMMA(loc);
+                case ';':
+                    return take(1), YYParser::make_SEMICOLON(loc);
+                case ':':
+                    return take(1), YYParser::make_COLON(loc);
+                case '?':
+                    return take(1), YYParser::make_COND(loc);
+                case '\'':
+                    if (end_ - cursor_ >= 3 && cursor_[1] != '\'' && cursor_[2] == '\'') {
+                        take(3);
+                        return makeLiteral(AST::ConstExprType::Char, start, 3, loc);
+                    }
+                    break;
+                case '"': {
+                    auto close = static_cast<const char *>(std::memchr(cursor_ + 1, '"', end_ - cursor_ - 1));
+                    if (close) {
+                        take(close + 1 - start);
+                        return YYParser::make_STRING(driver.intern(start, cursor_ - start), loc);
+                    }
+                    break;
+                }
+                default:
+                    if (is(*cursor_, kDigit))
+                        return lexNumber(driver);
+                    if (is(*cursor_, kIdent))
+                        return lexWord(driver);
+                    break;
+            }
+            // Same as the catch-all rule of the flex scanner.
+            take(1);
+            throw yy::parser::syntax_error(loc, "invalid character: " + std::string(1, *start));
+        }
+    }
+
+    yy::parser::symbol_type DirectLexer::lexNumber(YaccDriver &driver) {
+        auto &loc = driver.location;
+        const char *start = cursor_;
+        // The longest of the candidate rules wins, as in flex.
+        const char *int_end = skipRun<kDigit>(cursor_, end_);
+        const char *best = int_end;
+        Kind kind = YYParser::token::Token_INT;
+        if (int_end - start == 1 && *start == '0' && int_end != end_) {
+            const char *prefixed = int_end + 1;
+            const char *prefixed_end = prefixed;
+            Kind prefixed_kind = YYParser::token::Token_YYUNDEF;
+            switch (*int_end) {
+                case 'x':
+                    prefixed_end = skipHexDigits(prefixed, end_);
+                    prefixed_kind = YYParser::token::Token_HEX_INT;
+                    break;
+                case 'o':
+                    prefixed_end = skipDigitsIn(prefixed, end_, '7');
+                    prefixed_kind = YYParser::token::Token_OCT_INT;
+                    break;
+                case 'b':
+                    prefixed_end = skipDigitsIn(prefixed, end_, '1');
+                    prefixed_kind = YYParser::token::Token_BIN_INT;
+                    break;
+                default:
+                    break;
+            }
+            if (prefixed_end != prefixed) {
+                best = prefixed_end;
+                kind = prefixed_kind;
+            }
+        }
+        if (kind == YYParser::token::Token_INT && int_end + 1 < end_ && *int_end == '.' && is(int_end[1], kDigit)) {
+            best = skipRun<kDigit>(int_end + 1, end_);
+            kind = YYParser::token::Token_FLOAT;
+        }
+        cursor_ = best;
+        loc.columns(static_cast<int>(best - start));
+        switch (kind) {
+            case YYParser::token::Token_HEX_INT:
+                return makeLiteral(AST::ConstExprType::HexInt, start, best - start, loc);
+            case YYParser::token::Token_OCT_INT:
+                return makeLiteral(AST::ConstExprType::OctInt, start, best - start, loc);
+            case YYParser::token::Token_BIN_INT:
+                return makeLiteral(AST::ConstExprType::BinInt, start, best - start, loc);
+            case YYParser::token::Token_FLOAT:
+                return makeLiteral(AST::ConstExprType::Float, start, best - start, loc);
+            default:
+                return makeLiteral(AST::ConstExprType::Int, start, best - start, loc);
+        }
+    }
+
+    yy::parser::symbol_type DirectLexer::lexWord(YaccDriver &driver) {
+        auto &loc = driver.location;
+        const char *start = cursor_;
+        cursor_ = skipRun<kIdent>(cursor_ + 1, end_);
+        loc.columns(static_cast<int>(cursor_ - start));
+        return makeWord(driver, start, cursor_ - start, loc);
+    }
+} // namespace TinyCobalt::LexerParser
@@ -0,0 +1,34 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_SRC_LEXERPARSER_DIRECTLEXER_H_
+#define TINY_COBALT_SRC_LEXERPARSER_DIRECTLEXER_H_
+
+#include <span>
+#include "LexerParser/Parser.h"
+#include "Parser.tab.hpp"
+
+namespace TinyCobalt::LexerParser {
+    /**
+     * A hand-written, direct-coded scanner equivalent to the flex scanner in Lexer.ll. It scans an in-memory buffer
+     * in place and uses SIMD to skip blanks, identifier and digit runs. The produced token stream, including
+     * locations and errors, must match YaccLexer exactly.
+     */
+    class DirectLexer {
+    public:
+        explicit DirectLexer(std::span<const char> source) :
+            cursor_(source.data()), end_(source.data() + source.size()) {}
+
+        yy::parser::symbol_type yylex(YaccDriver &driver);
+
+    private:
+        yy::parser::symbol_type lexNumber(YaccDriver &driver);
+        yy::parser::symbol_type lexWord(YaccDriver &driver);
+
+        const char *cursor_;
+        const char *end_;
+    };
+} // namespace TinyCobalt::LexerParser
+
+#endif // TINY_COBALT_SRC_LEXERPARSER_DIRECTLEXER_H_
@@ -0,0 +1,117 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "LexerParser/IncrementalParser.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+#include "Common/Assert.h"
+
+namespace TinyCobalt::LexerParser {
+    namespace {
+        // Every edit adds the storage of its fragment to the root. Past this many, reparse the whole file so that
+        // storage of replaced statements is released.
+        constexpr std::size_t kMaxResources = 64;
+
+        bool isBlank(std::string_view text) { return text.find_first_not_of(" \t\r\n") == std::string_view::npos; }
+    } // namespace
+
+    IncrementalParser::IncrementalParser() {
+        // Offsets are relative to source_, so fragments are not registered with a SourceManager.
+        driver_.sources = nullptr;
+    }
+
+    int IncrementalParser::parse(std::string source) {
+        TINY_COBALT_ASSERT(source.size() < std::numeric_limits<SourceOffset>::max(),
+                           "IncrementalParser: source too large");
+        source_ = std::move(source);
+        root_ = nullptr;
+        ranges_.clear();
+        // Start a new pool so that the names of the dropped tree go away with it.
+        driver_.symbols = std::make_shared<Common::StringPool>();
+        AST::ASTRootPtr fragment;
+        std::vector<Range> ranges;
+        if (int err = parseRegion(0, source_.size(), fragment, ranges))
+            return err;
+        root_ = std::move(fragment);
+        ranges_ = std::move(ranges);
+        return 0;
+    }
+
+    int IncrementalParser::applyEdit(const TextEdit &edit) {
+        TINY_COBALT_ASSERT(edit.offset + edit.length <= source_.size(), "IncrementalParser: edit out of range");
+        auto old_size = source_.size();
+        source_.replace(edit.offset, edit.length, edit.text);
+        if (!root_ || root_->resources.size() > kMaxResources)
+            return parse(std::move(source_));
+
+        auto delta = static_cast<std::ptrdiff_t>(edit.text.size()) - static_cast<std::ptrdiff_t>(edit.length);
+        auto edit_end = edit.offset + edit.length;
+        // Statements [lo, hi) touch the edit, in old offsets.
+        auto lo = static_cast<std::size_t>(
+                std::ranges::find_if(ranges_, [&](const Range &range) { return range.end >= edit.offset; }) -
+                ranges_.begin());
+        auto hi = static_cast<std::size_t>(
+                std::ranges::find_if(ranges_, [&](const Range &range) { return range.begin > edit_end; }) -
+                ranges_.begin());
+        auto count = ranges_.size();
+
+        AST::ASTRootPtr fragment;
+        std::vector<Range> ranges;
+        while (true) {
+            // The region spans the gaps around the statements, so that it covers the edit even if it lies in a gap.
+            auto begin = lo > 0 ? ranges_[lo - 1].end : 0;
+            auto end = (hi < count ? ranges_[hi].begin : old_size) + delta;
+            if (parseRegion(begin, end, fragment, ranges) == 0)
+                break;
+            if (lo == 0 && hi == count) {
+                root_ = nullptr;
+                ranges_.clear();
+                return 1;
+            }
+            lo = lo > 0 ? lo - 1 : lo;
+            hi = hi < count ? hi + 1 : hi;
+        }
+
+        std::vector<AST::StmtNodePtr> children;
+        children.reserve(lo + fragment->children.size() + (count - hi));
+        children.insert(children.end(), root_->children.begin(), root_->children.begin() + lo);
+        children.insert(children.end(), fragment->children.begin(), fragment->children.end());
+        children.insert(children.end(), root_->children.begin() + hi, root_->children.end());
+
+        ranges.insert(ranges.begin(), ranges_.begin(), ranges_.begin() + lo);
+        for (auto it = ranges_.begin() + hi; it != ranges_.end(); ++it)
+            ranges.push_back({it->begin + delta, it->end + delta});
+
+        auto root = std::make_shared<AST::ASTRootNode>(std::move(children));
+        root->resources = root_->resources;
+        root->resources.insert(root->resources.end(), fragment->resources.begin(), fragment->resources.end());
+        root_ = std::move(root);
+        ranges_ = std::move(ranges);
+        return 0;
+    }
+
+    int IncrementalParser::parseRegion(std::size_t begin, std::size_t end, AST::ASTRootPtr &fragment,
+                                       std::vector<Range> &ranges) {
+        ranges.clear();
+        std::string_view text(source_.data() + begin, end - begin);
+        // The grammar needs at least one statement.
+        if (isBlank(text)) {
+            fragment = std::make_shared<AST::ASTRootNode>(std::vector<AST::StmtNodePtr>{});
+            return 0;
+        }
+        driver_.switchInput(std::span<const char>(text));
+        driver_.start = static_cast<SourceOffset>(begin);
+        if (int err = driver_.parse())
+            return err;
+        fragment = driver_.result;
+        for (const auto &loc: driver_.topLevelLocations)
+            ranges.push_back({loc.begin, loc.end});
+        return 0;
+    }
+} // namespace TinyCobalt::LexerParser
@@ -0,0 +1,78 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "Keywords.h"
+#include <array>
+#include <string_view>
+#include "AST/ASTNodeDecl.h"
+#include "Common/PerfectHash.h"
+
+namespace TinyCobalt::LexerParser {
+    namespace {
+        using Token = yy::parser::token;
+
+        struct Word {
+            std::string_view text;
+            Token::token_kind_type kind;
+        };
+
+        constexpr std::array kKeywords = {
+                Word{"if", Token::Token_IF},
+                Word{"else", Token::Token_ELSE},
+                Word{"while", Token::Token_WHILE},
+                Word{"for", Token::Token_FOR},
+                Word{"return", Token::Token_RETURN},
+                Word{"break", Token::Token_BREAK},
+                Word{"continue", Token::Token_CONTINUE},
+                Word{"struct", Token::Token_STRUCT},
+                Word{"using", Token::Token_USING},
+                Word{"static_cast", Token::Token_STATIC_CAST},
+                Word{"const_cast", Token::Token_CONST_CAST},
+                Word{"reinterpret_cast", Token::Token_REINTERPRET_CAST},
+                Word{"true", Token::Token_BOOL},
+                Word{"false", Token::Token_BOOL},
+        };
+
+        constexpr std::size_t kWordCount = kKeywords.size() + AST::BuiltInType::kNames.size();
+
+        // Keywords followed by the builtin type names.
+        constexpr std::array<Word, kWordCount> kWords = [] {
+            std::array<Word, kWordCount> words{};
+            std::size_t i = 0;
+            for (auto word: kKeywords)
+                words[i++] = word;
+            for (auto name: AST::BuiltInType::kNames)
+                words[i++] = Word{name, Token::Token_TYPENAME};
+            return words;
+        }();
+
+        constexpr Common::PerfectHash kWordHash([] {
+            std::array<std::string_view, kWordCount> texts{};
+            for (std::size_t i = 0; i < kWordCount; ++i)
+                texts[i] = kWords[i].text;
+            return texts;
+        }());
+    } // namespace
+
+    yy::parser::symbol_type makeWord(YaccDriver &driver, const char *text, std::size_t size, const Location &loc) {
+        std::string_view word(text, size);
+        auto kind = Token::Token_IDENTIFIER;
+        if (auto index = kWordHash.find(word))
+            kind = kWords[*index].kind;
+        // TODO: Currently we use upper case beginning to distinguish type names from other identifiers.
+        else if (text[0] >= 'A' && text[0] <= 'Z')
+            kind = Token::Token_TYPENAME;
+
+        switch (kind) {
+            case Token::Token_IDENTIFIER:
+                return yy::parser::make_IDENTIFIER(driver.intern(text, size), loc);
+            case Token::Token_TYPENAME:
+                return yy::parser::make_TYPENAME(driver.intern(text, size), loc);
+            case Token::Token_BOOL:
+                return yy::parser::make_BOOL(word == "true", loc);
+            default:
+                return yy::parser::symbol_type(kind, loc);
+        }
+    }
+} // namespace TinyCobalt::LexerParser
@@ -0,0 +1,21 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_SRC_LEXERPARSER_KEYWORDS_H_
+#define TINY_COBALT_SRC_LEXERPARSER_KEYWORDS_H_
+
+#include <cstddef>
+#include "LexerParser/Location.h"
+#include "LexerParser/Parser.h"
+#include "Parser.tab.hpp"
+
+namespace TinyCobalt::LexerParser {
+    /**
+     * Build the token for a word matched by [a-zA-Z_][a-zA-Z_0-9]*. Keywords, boolean literals and builtin type names
+     * are recognized with a compile-time perfect hash. Both scanner backends use this, so they classify words the same.
+     */
+    yy::parser::symbol_type makeWord(YaccDriver &driver, const char *text, std::size_t size, const Location &loc);
+} // namespace TinyCobalt::LexerParser
+
+#endif // TINY_COBALT_SRC_LEXERPARSER_KEYWORDS_H_
@@ -3,11 +3,18 @@
  */
 
 %{
+# include <algorithm>
 # include <cerrno>
 # include <climits>
 # include <cstdlib>
 # include <cstring> // strerror
+# include <iterator>
 # include <string>
+# include <vector>
+# include "DirectLexer.h"
+# include "Keywords.h"
+# include "Literals.h"
+# include "TokenCache.h"
 # include "LexerParser/YaccDriver.h"
 # include "Parser.tab.hpp"
 
@@ -89,7 +96,8 @@
 
 %}
 
-%option c++ noyywrap nounput noinput batch debug
+/* The debug option is passed by the build in debug mode only, since it adds a check to every match. */
+%option c++ noyywrap nounput noinput batch
 
 %option yyclass="TinyCobalt::LexerParser::YaccLexer"
 
@@ -101,7 +109,6 @@
   make_NUMBER (const std::string &s, const yy::parser::location_type& loc);
 %}
 
-id      [a-z_][a-zA-Z_0-9]*
 int     [0-9]+
 hex_int 0x[0-9a-fA-F]+
 oct_int 0o[0-7]+
@@ -109,10 +116,9 @@ bin_int 0b[01]+
 float   [0-9]*\.[0-9]+
 char    \'[^\']\'
 string  \"[^\"]*\"
-bool    true|false
-/* TODO: Currently we use upper case beginning to distinguish type names from other identifiers. */
-type    uint|int|float|char|bool|void|[A-Z][a-zA-Z_0-9]*
-blank   [ \t\r]
+/* Keywords, booleans and type names are told apart from identifiers in makeWord. */
+word    [a-zA-Z_][a-zA-Z_0-9]*
+blank   [ \t\r\n]
 
 %{
   // Code run each time a pattern is matched.
@@ -126,7 +132,6 @@ blank   [ \t\r]
   loc.step ();
 %}
 {blank}+   loc.step();
-\n+        loc.lines(yyleng); loc.step();
 
 "-"        return yy::parser::make_MINUS(loc);
 "+"        return yy::parser::make_PLUS(loc);
@@ -175,30 +180,14 @@ blank   [ \t\r]
 ":"        return yy::parser::make_COLON(loc);
 "?"        return yy::parser::make_COND(loc);
 
-"if"       return yy::parser::make_IF(loc);
-"else"     return yy::parser::make_ELSE(loc);
-"while"    return yy::parser::make_WHILE(loc);
-"for"      return yy::parser::make_FOR(loc);
-"return"   return yy::parser::make_RETURN(loc);
-"break"    return yy::parser::make_BREAK(loc);
-"continue" return yy::parser::make_CONTINUE(loc);
-"struct"   return yy::parser::make_STRUCT(loc);
-"using"    return yy::parser::make_USING(loc);
-
-"static_cast"      return yy::parser::make_STATIC_CAST(loc);
-"const_cast"       return yy::parser::make_CONST_CAST(loc);
-"reinterpret_cast" return yy::parser::make_REINTERPRET_CAST(loc);
-
-{int}      return yy::parser::make_INT(yytext, loc);
-{hex_int}  return yy::parser::make_HEX_INT(yytext, loc);
-{oct_int}  return yy::parser::make_OCT_INT(yytext, loc);
-{bin_int}  return yy::parser::make_BIN_INT(yytext, loc);
-{float}    return yy::parser::make_FLOAT(yytext, loc);
-{char}     return yy::parser::make_CHAR(yytext, loc);
-{string}   return yy::parser::make_STRING(yytext, loc);
-{bool}     return yy::parser::make_BOOL(yytext, loc);
-{type}     return yy::parser::make_TYPENAME(yytext, loc);
-{id}       return yy::parser::make_IDENTIFIER (yytext, loc);
+{int}      return makeLiteral(AST::ConstExprType::Int, yytext, yyleng, loc);
+{hex_int}  return makeLiteral(AST::ConstExprType::HexInt, yytext, yyleng, loc);
+{oct_int}  return makeLiteral(AST::ConstExprType::OctInt, yytext, yyleng, loc);
+{bin_int}  return makeLiteral(AST::ConstExprType::BinInt, yytext, yyleng, loc);
+{float}    return makeLiteral(AST::ConstExprType::Float, yytext, yyleng, loc);
+{char}     return makeLiteral(AST::ConstExprType::Char, yytext, yyleng, loc);
+{string}   return yy::parser::make_STRING(driver.intern(yytext, yyleng), loc);
+{word}     return makeWord(driver, yytext, yyleng, loc);
 .          {
              throw yy::parser::syntax_error
                (loc, "invalid character: " + std::string(yytext));
@@ -206,14 +195,69 @@ blank   [ \t\r]
 <<EOF>>    return yy::parser::make_YYEOF (loc);
 %%
 
+int TinyCobalt::LexerParser::YaccLexer::LexerInput (char *buf, int max_size)
+{
+  if (!from_memory_)
+    return yyFlexLexer::LexerInput(buf, max_size);
+  // Copy the next chunk straight from the mapped source into flex's buffer.
+  std::size_t count = std::min(source_.size() - cursor_, static_cast<std::size_t>(max_size));
+  std::memcpy(buf, source_.data() + cursor_, count);
+  cursor_ += count;
+  return static_cast<int>(count);
+}
+
 void TinyCobalt::LexerParser::YaccDriver::scan_begin ()
 {
-  this->lexer = new YaccLexer;
+  this->templateDepth = 0;
+  this->lastTokenKind = 0;
+  this->pendingGreater.reset();
+  std::span<const char> text;
+  if (this->sources && !this->sharedSources)
+    this->sources = std::make_shared<SourceManager>();
+  if (this->sources) {
+    const auto &entry = this->sources->addFile(this->file.empty() ? "<input>" : this->file, this->readInput());
+    this->location.initialize(entry.base);
+    text = entry.text();
+  } else {
+    this->buffer.emplace(this->readInput());
+    this->location.initialize(this->start);
+    text = this->buffer->data();
+  }
+  if (!this->tokenCacheDir.empty()) {
+    this->tokenCache = new TokenCache();
+    if (this->tokenCache->open(this->tokenCacheDir, text, this->location.begin, *this))
+      return;
+  }
+  if (this->lexerKind == LexerKind::Direct) {
+    this->directLexer = new DirectLexer(text);
+    return;
+  }
+  this->lexer = new YaccLexer(text);
+  this->lexer->switch_streams(nullptr, this->os);
+#if YYDEBUG
   this->lexer->set_debug(trace_scanning);
-  this->lexer->switch_streams(*(this->is), *(this->os));
+#endif
+}
+
+TinyCobalt::LexerParser::SourceBuffer TinyCobalt::LexerParser::YaccDriver::readInput () const
+{
+  if (this->mapFile)
+    return SourceBuffer::map(this->file);
+  // The source manager decodes locations after the parse, when a borrowed span may be gone, so it gets a copy. Stream
+  // input is read into memory as well.
+  if (this->span && !this->sources)
+    return SourceBuffer(*this->span);
+  if (this->span)
+    return SourceBuffer(std::vector<char>(this->span->begin(), this->span->end()));
+  return SourceBuffer(std::vector<char>(std::istreambuf_iterator<char>(*this->is), std::istreambuf_iterator<char>()));
 }
 
 void TinyCobalt::LexerParser::YaccDriver::scan_end ()
 {
   delete this->lexer;
+  delete this->directLexer;
+  delete this->tokenCache;
+  this->lexer = nullptr;
+  this->directLexer = nullptr;
+  this->tokenCache = nullptr;
 }
@@ -0,0 +1,37 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "Literals.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <variant>
+#include "AST/ASTNodeDecl.h"
+
+namespace TinyCobalt::LexerParser {
+    yy::parser::symbol_type makeLiteral(AST::ConstExprType type, const char *text, std::size_t size,
+                                        const Location &loc) {
+        AST::ConstExprNode::Value value;
+        try {
+            value = AST::ConstExprNode::decode(std::string_view(text, size), type);
+        } catch (const std::exception &e) {
+            throw yy::parser::syntax_error(loc, e.what());
+        }
+        switch (type) {
+            case AST::ConstExprType::HexInt:
+                return yy::parser::make_HEX_INT(std::get<std::uint64_t>(value), loc);
+            case AST::ConstExprType::OctInt:
+                return yy::parser::make_OCT_INT(std::get<std::uint64_t>(value), loc);
+            case AST::ConstExprType::BinInt:
+                return yy::parser::make_BIN_INT(std::get<std::uint64_t>(value), loc);
+            case AST::ConstExprType::Float:
+                return yy::parser::make_FLOAT(std::get<double>(value), loc);
+            case AST::ConstExprType::Char:
+                return yy::parser::make_CHAR(std::get<char>(value), loc);
+            default:
+                return yy::parser::make_INT(std::get<std::uint64_t>(value), loc);
+        }
+    }
+} // namespace TinyCobalt::LexerParser
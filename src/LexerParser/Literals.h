@@ -0,0 +1,23 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_SRC_LEXERPARSER_LITERALS_H_
+#define TINY_COBALT_SRC_LEXERPARSER_LITERALS_H_
+
+#include <cstddef>
+#include "AST/ExprNode.h"
+#include "LexerParser/Location.h"
+#include "LexerParser/Parser.h"
+#include "Parser.tab.hpp"
+
+namespace TinyCobalt::LexerParser {
+    /**
+     * Build the token for an integer, float or char literal with its decoded value. Both scanner backends use this.
+     * @throw yy::parser::syntax_error if the value does not fit its type.
+     */
+    yy::parser::symbol_type makeLiteral(AST::ConstExprType type, const char *text, std::size_t size,
+                                        const Location &loc);
+} // namespace TinyCobalt::LexerParser
+
+#endif // TINY_COBALT_SRC_LEXERPARSER_LITERALS_H_
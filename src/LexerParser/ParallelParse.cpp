@@ -0,0 +1,59 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "LexerParser/ParallelParse.h"
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <thread>
+#include "Common/ThreadPool.h"
+#include "LexerParser/Parser.h"
+
+namespace TinyCobalt::LexerParser {
+    namespace {
+        ParseResult parseFile(const std::string &file, const std::shared_ptr<SourceManager> &sources) {
+            ParseResult result{.file = file};
+            try {
+                Parser parser;
+                parser.setSourceManager(sources).switchInputFile(file);
+                result.error = parser.parse();
+                result.diagnostics = parser.diagnostics();
+                if (result.error == 0)
+                    result.root = parser.result();
+            } catch (const std::exception &e) {
+                result.error = -1;
+                result.message = e.what();
+            }
+            return result;
+        }
+    } // namespace
+
+    std::vector<ParseResult> parseFiles(const std::vector<std::string> &files, std::size_t jobs) {
+        return parseFiles(files, std::make_shared<SourceManager>(), jobs);
+    }
+
+    std::vector<ParseResult> parseFiles(const std::vector<std::string> &files, std::shared_ptr<SourceManager> sources,
+                                        std::size_t jobs) {
+        if (jobs == 0)
+            jobs = std::thread::hardware_concurrency();
+        jobs = std::clamp<std::size_t>(jobs, 1, std::max<std::size_t>(files.size(), 1));
+
+        std::vector<ParseResult> results;
+        results.reserve(files.size());
+        if (jobs == 1) {
+            for (const auto &file: files)
+                results.push_back(parseFile(file, sources));
+            return results;
+        }
+
+        Common::ThreadPool pool(jobs);
+        std::vector<std::future<ParseResult>> futures;
+        futures.reserve(files.size());
+        for (const auto &file: files)
+            futures.push_back(pool.submit([&file, &sources] { return parseFile(file, sources); }));
+        for (auto &future: futures)
+            results.push_back(future.get());
+        return results;
+    }
+} // namespace TinyCobalt::LexerParser
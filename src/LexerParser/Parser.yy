@@ -13,14 +13,25 @@
 
 %define api.token.constructor
 %define api.value.type variant
-%define parse.assert
+// parse.assert is passed by the build in debug mode only, since it tags every semantic value with its type.
 
 %code requires {
+// Traces are compiled in only when the build enables them, see src/xmake.lua.
+#ifndef YYDEBUG
+#ifdef TINYCOBALT_ENABLE_TRACE
+#define YYDEBUG 1
+#else
+#define YYDEBUG 0
+#endif
+#endif
+
+#include <cstdint>
 #include "AST/ExprNode.h"
 #include "AST/StmtNode.h"
 #include "AST/TypeNode.h"
 #include "AST/ASTNode.h"
 #include "AST/ASTNodeDecl.h"
+#include "Common/Symbol.h"
 #include "LexerParser/Location.h"
 
 using namespace TinyCobalt;
@@ -43,7 +54,19 @@ namespace TinyCobalt::LexerParser {
 %code {
 #include "LexerParser/YaccDriver.h"
 
-#define yylex driver.lexer->yylex
+#define yylex TinyCobalt::LexerParser::nextToken
+
+// The default from bison, which also records the location for the nodes created by the rule.
+#define YYLLOC_DEFAULT(Current, Rhs, N)                                                                                \
+    do {                                                                                                               \
+        if (N) {                                                                                                       \
+            (Current).begin = YYRHSLOC(Rhs, 1).begin;                                                                  \
+            (Current).end = YYRHSLOC(Rhs, N).end;                                                                      \
+        } else {                                                                                                       \
+            (Current).begin = (Current).end = YYRHSLOC(Rhs, 0).end;                                                    \
+        }                                                                                                              \
+        driver.reducing = (Current);                                                                                   \
+    } while (false)
 }
 
 %define api.token.prefix {Token_}
@@ -69,7 +92,7 @@ namespace TinyCobalt::LexerParser {
     BITOR "|"
     BITXOR "^"
     BITNOT "~"
-    // TODO: flex may not be able to distinguish between ">>" in template and ">>" in bitshift
+    // Inside template arguments, nextToken splits ">>" into two ">".
     LSHIFT "<<"
     RSHIFT ">>"
     AND "&&"
@@ -112,16 +135,16 @@ namespace TinyCobalt::LexerParser {
     CONST_CAST "const_cast"
     REINTERPRET_CAST "reinterpret_cast"
 
-%token <std::string> IDENTIFIER "identifier"
-%token <std::string> TYPENAME "typename" // TODO: Merge TYPENAME token with IDENTIFIER token
-%token <std::string> INT "int"
-%token <std::string> HEX_INT "hex_int"
-%token <std::string> OCT_INT "oct_int"
-%token <std::string> BIN_INT "bin_int"
-%token <std::string> FLOAT "float"
-%token <std::string> BOOL "bool"
-%token <std::string> CHAR "const_char"
-%token <std::string> STRING "const_string"
+%token <Common::Symbol> IDENTIFIER "identifier"
+%token <Common::Symbol> TYPENAME "typename" // TODO: Merge TYPENAME token with IDENTIFIER token
+%token <std::uint64_t> INT "int"
+%token <std::uint64_t> HEX_INT "hex_int"
+%token <std::uint64_t> OCT_INT "oct_int"
+%token <std::uint64_t> BIN_INT "bin_int"
+%token <double> FLOAT "float"
+%token <bool> BOOL "bool"
+%token <char> CHAR "const_char"
+%token <Common::Symbol> STRING "const_string"
 
 // Stmt
 %nterm <AST::IfPtr> if;
@@ -143,6 +166,7 @@ namespace TinyCobalt::LexerParser {
 
 %nterm <AST::StmtNodePtr> stmt;
 %nterm <std::vector<AST::StmtNodePtr>> stmts;
+%nterm <std::vector<AST::StmtNodePtr>> top_stmts;
 
 // Type
 %nterm <AST::SimpleTypePtr> simple_type;
@@ -172,10 +196,16 @@ namespace TinyCobalt::LexerParser {
 
 %start unit;
 unit: 
-  stmts { driver.result = driver.allocNode<AST::ASTRootNode>($1); }
+  top_stmts { driver.result = driver.allocNode<AST::ASTRootNode>($1); }
+
+// Same as stmts, but each statement is handed to the driver as soon as it is complete.
+top_stmts:
+  stmt { driver.pushTopLevel($$, $1, @1); }
+| top_stmts stmt { $$ = std::move($1); driver.pushTopLevel($$, $2, @2); }
 
 block:
   "{" stmts "}" { $$ = driver.allocNode<AST::BlockNode>($2); }
+| "{" error "}" { $$ = driver.allocNode<AST::BlockNode>(std::vector<AST::StmtNodePtr>{}); }
 
 if:
   "if" "(" expr ")" stmt { $$ = driver.allocNode<AST::IfNode>($3, $5, nullptr); }
@@ -240,6 +270,8 @@ stmt:
 | alias_def { $$ = $1; }
 | expr_stmt { $$ = $1; }
 | ";" { $$ = driver.allocNode<AST::EmptyStmtNode>(); }
+// Skip to the end of the statement and go on, so that one parse reports all errors.
+| error ";" { $$ = driver.allocNode<AST::EmptyStmtNode>(); }
 
 stmts:
   stmt { $$ = {$1}; }
@@ -271,14 +303,14 @@ template_arguments:
 | template_arguments "," const_expr { $$ = std::move($1); $$.emplace_back($3); }
 
 const_expr:
-  "int" { $$ = driver.allocNode<AST::ConstExprNode>($1, AST::ConstExprType::Int); }
-| "hex_int" { $$ = driver.allocNode<AST::ConstExprNode>($1, AST::ConstExprType::HexInt); }
-| "oct_int" { $$ = driver.allocNode<AST::ConstExprNode>($1, AST::ConstExprType::OctInt); }
-| "bin_int" { $$ = driver.allocNode<AST::ConstExprNode>($1, AST::ConstExprType::BinInt); }
-| "float" { $$ = driver.allocNode<AST::ConstExprNode>($1, AST::ConstExprType::Float); }
-| "const_string" { $$ = driver.allocNode<AST::ConstExprNode>($1, AST::ConstExprType::String); }
-| "const_char" { $$ = driver.allocNode<AST::ConstExprNode>($1, AST::ConstExprType::Char); }
-| "bool" { $$ = driver.allocNode<AST::ConstExprNode>($1, AST::ConstExprType::Bool); }
+  "int" { $$ = driver.allocNode<AST::ConstExprNode>(AST::ConstExprType::Int, $1); }
+| "hex_int" { $$ = driver.allocNode<AST::ConstExprNode>(AST::ConstExprType::HexInt, $1); }
+| "oct_int" { $$ = driver.allocNode<AST::ConstExprNode>(AST::ConstExprType::OctInt, $1); }
+| "bin_int" { $$ = driver.allocNode<AST::ConstExprNode>(AST::ConstExprType::BinInt, $1); }
+| "float" { $$ = driver.allocNode<AST::ConstExprNode>(AST::ConstExprType::Float, $1); }
+| "const_string" { $$ = driver.allocNode<AST::ConstExprNode>(AST::ConstExprType::String, $1); }
+| "const_char" { $$ = driver.allocNode<AST::ConstExprNode>(AST::ConstExprType::Char, $1); }
+| "bool" { $$ = driver.allocNode<AST::ConstExprNode>(AST::ConstExprType::Bool, $1); }
 
 variable: "identifier" { $$ = driver.allocNode<AST::VariableNode>($1); }
 
@@ -383,5 +415,5 @@ expr:
 %%
 
 void TinyCobalt::LexerParser::yy::parser::error(const location_type& l, const std::string& m){
-    std::cerr << l << ": " << m << std::endl;
+    driver.report(l, m);
 }
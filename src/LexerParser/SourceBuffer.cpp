@@ -0,0 +1,90 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "LexerParser/SourceBuffer.h"
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TINY_COBALT_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define TINY_COBALT_HAS_MMAP 0
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace TinyCobalt::LexerParser {
+
+    SourceBuffer::SourceBuffer(SourceBuffer &&other) noexcept :
+        data_(std::exchange(other.data_, {})), mapped_(std::exchange(other.mapped_, false)),
+        owned_(std::move(other.owned_)) {}
+
+    SourceBuffer &SourceBuffer::operator=(SourceBuffer &&other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, {});
+            mapped_ = std::exchange(other.mapped_, false);
+            owned_ = std::move(other.owned_);
+        }
+        return *this;
+    }
+
+    SourceBuffer::~SourceBuffer() { release(); }
+
+    void SourceBuffer::release() noexcept {
+#if TINY_COBALT_HAS_MMAP
+        if (mapped_)
+            ::munmap(const_cast<char *>(data_.data()), data_.size());
+#endif
+        data_ = {};
+        mapped_ = false;
+        owned_.clear();
+    }
+
+#if TINY_COBALT_HAS_MMAP
+    SourceBuffer SourceBuffer::map(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "Cannot stat " + path);
+        }
+        SourceBuffer buffer;
+        auto size = static_cast<std::size_t>(st.st_size);
+        // mmap rejects zero-length mappings, and an empty file needs no storage anyway.
+        if (size != 0) {
+            void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), "Cannot map " + path);
+            }
+            ::madvise(addr, size, MADV_SEQUENTIAL);
+            buffer.data_ = {static_cast<const char *>(addr), size};
+            buffer.mapped_ = true;
+        }
+        ::close(fd);
+        return buffer;
+    }
+#else
+    SourceBuffer SourceBuffer::map(const std::string &path) {
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs)
+            throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), "Cannot open " + path);
+        SourceBuffer buffer;
+        buffer.owned_.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        buffer.data_ = buffer.owned_;
+        return buffer;
+    }
+#endif
+
+} // namespace TinyCobalt::LexerParser
@@ -0,0 +1,74 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "LexerParser/SourceManager.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace TinyCobalt::LexerParser {
+
+    const SourceManager::File &SourceManager::addFile(std::string name, SourceBuffer buffer) {
+        std::unique_lock lock(mutex_);
+        auto size = buffer.size();
+        // One offset past the end of the file is reserved as its end position.
+        if (size >= std::numeric_limits<SourceOffset>::max() - next_)
+            throw std::length_error("SourceManager: source offset space exhausted by " + name);
+        auto &entry = files_.emplace_back();
+        entry.name = std::move(name);
+        entry.buffer = std::move(buffer);
+        entry.base = next_;
+        next_ += static_cast<SourceOffset>(size) + 1;
+        return entry;
+    }
+
+    const SourceManager::File *SourceManager::findFile(SourceOffset offset) const {
+        std::shared_lock lock(mutex_);
+        // Files are sorted by base.
+        auto it = std::ranges::upper_bound(files_, offset, {}, &Entry::base);
+        if (it == files_.begin())
+            return nullptr;
+        --it;
+        return offset <= it->end() ? &*it : nullptr;
+    }
+
+    SourceManager::Decoded SourceManager::decode(SourceOffset offset) const {
+        auto *file = static_cast<const Entry *>(findFile(offset));
+        if (!file)
+            return {"", 0, 0};
+        const auto &starts = lineStarts(*file);
+        auto relative = offset - file->base;
+        auto line = std::ranges::upper_bound(starts, relative) - starts.begin();
+        return {file->name, static_cast<std::uint32_t>(line), relative - starts[line - 1] + 1};
+    }
+
+    std::string SourceManager::format(const Location &loc) const {
+        auto begin = decode(loc.begin);
+        std::string res = std::string(begin.file) + ':' + std::to_string(begin.line) + '.' +
+                          std::to_string(begin.column);
+        if (loc.end <= loc.begin + 1)
+            return res;
+        // The last character of the location, like the bison location printer.
+        auto end = decode(loc.end - 1);
+        if (end.line != begin.line)
+            res += '-' + std::to_string(end.line) + '.' + std::to_string(end.column);
+        else
+            res += '-' + std::to_string(end.column);
+        return res;
+    }
+
+    const std::vector<std::uint32_t> &SourceManager::lineStarts(const Entry &entry) const {
+        std::call_once(entry.lines_once, [&entry] {
+            auto text = entry.text();
+            entry.line_starts.push_back(0);
+            for (auto *p = text.data(), *end = text.data() + text.size();
+                 (p = static_cast<const char *>(std::memchr(p, '\n', end - p))); ++p)
+                entry.line_starts.push_back(static_cast<std::uint32_t>(p - text.data() + 1));
+        });
+        return entry.line_starts;
+    }
+
+} // namespace TinyCobalt::LexerParser
@@ -0,0 +1,261 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "TokenCache.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include "Common/AtomicFile.h"
+#include "LexerParser/YaccDriver.h"
+
+#ifndef TINYCOBALT_LEXER_DIGEST
+#error "TINYCOBALT_LEXER_DIGEST must be set by the build to a digest of the scanner sources"
+#endif
+
+namespace TinyCobalt::LexerParser {
+    namespace {
+        using Token = yy::parser::token;
+        using SymbolKind = yy::parser::symbol_kind;
+
+        // Token kinds are stored as symbol kinds, which api.token.raw makes the same.
+        static_assert(static_cast<int>(SymbolKind::S_IDENTIFIER) == Token::Token_IDENTIFIER);
+        static_assert(static_cast<int>(SymbolKind::S_STRING) == Token::Token_STRING);
+
+        constexpr char kMagic[4] = {'T', 'C', 'T', 'K'};
+        // The version of the file layout. Changes of the scanners are caught by kLexerDigest.
+        constexpr std::uint32_t kVersion = 3;
+
+        // Set by the build from the sources of the scanners and the grammar, so that a cache written by other lexer
+        // rules is never replayed.
+        constexpr std::string_view kLexerDigest = TINYCOBALT_LEXER_DIGEST;
+
+        struct Header {
+            char magic[4];
+            std::uint32_t version;
+            // Changes whenever tokens are added to the grammar.
+            std::uint32_t token_kinds;
+            std::uint32_t digest_size;
+            std::uint64_t source_size;
+            std::uint64_t source_hash[2];
+            std::uint64_t tokens;
+            std::uint64_t strings;
+        };
+
+        constexpr std::uint64_t kPrime1 = 0x9e3779b185ebca87ULL;
+        constexpr std::uint64_t kPrime2 = 0xc2b2ae3d27d4eb4fULL;
+        constexpr std::uint64_t kPrime3 = 0x165667b19e3779f9ULL;
+
+        std::uint64_t load64(const char *p) {
+            std::uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            return word;
+        }
+
+        std::uint64_t mix(std::uint64_t acc, std::uint64_t word) {
+            return std::rotl(acc + word * kPrime2, 31) * kPrime1;
+        }
+
+        std::uint64_t avalanche(std::uint64_t h) {
+            h = (h ^ (h >> 33)) * kPrime2;
+            h = (h ^ (h >> 29)) * kPrime3;
+            return h ^ (h >> 32);
+        }
+
+        /**
+         * A 128-bit hash in the manner of xxHash64: four independent lanes take a word each per 32 bytes, so the whole
+         * text is hashed at memory speed. Not meant to resist crafted collisions; words are read in host byte order
+         * like the rest of the file.
+         */
+        TokenCache::Hash hashText(std::span<const char> text) {
+            std::uint64_t lanes[4] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+            const char *p = text.data(), *end = p + text.size();
+            for (; end - p >= 32; p += 32)
+                for (int i = 0; i < 4; ++i)
+                    lanes[i] = mix(lanes[i], load64(p + 8 * i));
+            for (int i = 0; end - p >= 8; p += 8, ++i)
+                lanes[i] = mix(lanes[i], load64(p));
+            std::uint64_t tail = 0;
+            if (p != end)
+                std::memcpy(&tail, p, static_cast<std::size_t>(end - p));
+            lanes[3] = mix(lanes[3], tail ^ text.size());
+            return {avalanche(std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + lanes[3]),
+                    avalanche(std::rotl(lanes[3], 18) + std::rotl(lanes[2], 1) + std::rotl(lanes[1], 7) + lanes[0])};
+        }
+
+        bool hasSymbol(int kind) {
+            return kind == Token::Token_IDENTIFIER || kind == Token::Token_TYPENAME || kind == Token::Token_STRING;
+        }
+    } // namespace
+
+    bool TokenCache::open(const std::string &dir, std::span<const char> text, SourceOffset base, YaccDriver &driver) {
+        hash_ = hashText(text);
+        size_ = text.size();
+        base_ = base;
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.tok", static_cast<unsigned long long>(hash_[0]));
+        file_ = (std::filesystem::path(dir) / name).string();
+
+        std::error_code ec;
+        if (std::filesystem::exists(file_, ec)) {
+            try {
+                replaying_ = load(SourceBuffer::map(file_), driver);
+            } catch (const std::exception &) {
+                replaying_ = false;
+            }
+        }
+        if (!replaying_) {
+            records_.clear();
+            symbols_.clear();
+        }
+        return replaying_;
+    }
+
+    bool TokenCache::load(const SourceBuffer &file, YaccDriver &driver) {
+        Header header;
+        if (file.size() < sizeof(header))
+            return false;
+        std::memcpy(&header, file.begin(), sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+            header.token_kinds != SymbolKind::YYNTOKENS || header.digest_size != kLexerDigest.size() ||
+            header.source_size != size_ || header.source_hash[0] != hash_[0] || header.source_hash[1] != hash_[1])
+            return false;
+
+        const char *cursor = file.begin() + sizeof(header);
+        auto remaining = [&] { return static_cast<std::size_t>(file.end() - cursor); };
+        if (remaining() < kLexerDigest.size() || std::memcmp(cursor, kLexerDigest.data(), kLexerDigest.size()) != 0)
+            return false;
+        cursor += kLexerDigest.size();
+
+        if (header.tokens > remaining() / sizeof(Record))
+            return false;
+        const char *records = cursor;
+        cursor += header.tokens * sizeof(Record);
+
+        std::vector<std::string_view> strings;
+        strings.reserve(std::min<std::uint64_t>(header.strings, remaining() / sizeof(std::uint32_t)));
+        for (std::uint64_t i = 0; i < header.strings; ++i) {
+            std::uint32_t size;
+            if (remaining() < sizeof(size))
+                return false;
+            std::memcpy(&size, cursor, sizeof(size));
+            cursor += sizeof(size);
+            if (remaining() < size)
+                return false;
+            strings.emplace_back(cursor, size);
+            cursor += size;
+        }
+
+        if (remaining() != 0)
+            return false;
+
+        records_.resize(header.tokens);
+        std::memcpy(records_.data(), records, header.tokens * sizeof(Record));
+        for (const auto &record: records_)
+            if (record.kind >= static_cast<std::uint32_t>(SymbolKind::YYNTOKENS) || record.begin > record.end ||
+                record.end > size_ || (hasSymbol(record.kind) && record.payload >= strings.size()))
+                return false;
+        symbols_.reserve(strings.size());
+        for (auto text: strings)
+            symbols_.push_back(driver.intern(text.data(), text.size()));
+        return true;
+    }
+
+    yy::parser::symbol_type TokenCache::next(YaccDriver &driver) {
+        auto &loc = driver.location;
+        if (cursor_ == records_.size()) {
+            loc.step();
+            return yy::parser::make_YYEOF(loc);
+        }
+        const auto &record = records_[cursor_++];
+        loc = Location(base_ + record.begin, base_ + record.end);
+        switch (record.kind) {
+            case Token::Token_IDENTIFIER:
+            case Token::Token_TYPENAME:
+            case Token::Token_STRING:
+                return yy::parser::symbol_type(record.kind, symbols_[record.payload], loc);
+            case Token::Token_INT:
+            case Token::Token_HEX_INT:
+            case Token::Token_OCT_INT:
+            case Token::Token_BIN_INT:
+                return yy::parser::symbol_type(record.kind, record.payload, loc);
+            case Token::Token_FLOAT:
+                return yy::parser::symbol_type(record.kind, std::bit_cast<double>(record.payload), loc);
+            case Token::Token_BOOL:
+                return yy::parser::symbol_type(record.kind, record.payload != 0, loc);
+            case Token::Token_CHAR:
+                return yy::parser::symbol_type(record.kind, static_cast<char>(record.payload), loc);
+            default:
+                return yy::parser::symbol_type(record.kind, loc);
+        }
+    }
+
+    void TokenCache::record(const yy::parser::symbol_type &token) {
+        auto kind = static_cast<int>(token.kind());
+        Record record{0, token.location.begin - base_, token.location.end - base_, static_cast<std::uint32_t>(kind), 0};
+        switch (kind) {
+            case Token::Token_IDENTIFIER:
+            case Token::Token_TYPENAME:
+            case Token::Token_STRING:
+                record.payload = addString(token.value.as<Common::Symbol>().view());
+                break;
+            case Token::Token_INT:
+            case Token::Token_HEX_INT:
+            case Token::Token_OCT_INT:
+            case Token::Token_BIN_INT:
+                record.payload = token.value.as<std::uint64_t>();
+                break;
+            case Token::Token_FLOAT:
+                record.payload = std::bit_cast<std::uint64_t>(token.value.as<double>());
+                break;
+            case Token::Token_BOOL:
+                record.payload = token.value.as<bool>();
+                break;
+            case Token::Token_CHAR:
+                record.payload = static_cast<unsigned char>(token.value.as<char>());
+                break;
+            default:
+                break;
+        }
+        records_.push_back(record);
+    }
+
+    std::uint32_t TokenCache::addString(std::string_view text) {
+        auto [it, inserted] = string_index_.try_emplace(text, static_cast<std::uint32_t>(strings_.size()));
+        if (inserted)
+            strings_.push_back(text);
+        return it->second;
+    }
+
+    bool TokenCache::store() const {
+        return Common::writeFileAtomically(file_, [this](std::ostream &os) {
+            Header header{};
+            std::memcpy(header.magic, kMagic, sizeof(kMagic));
+            header.version = kVersion;
+            header.token_kinds = SymbolKind::YYNTOKENS;
+            header.digest_size = static_cast<std::uint32_t>(kLexerDigest.size());
+            header.source_size = size_;
+            header.source_hash[0] = hash_[0];
+            header.source_hash[1] = hash_[1];
+            header.tokens = records_.size();
+            header.strings = strings_.size();
+            os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            os.write(kLexerDigest.data(), static_cast<std::streamsize>(kLexerDigest.size()));
+            os.write(reinterpret_cast<const char *>(records_.data()),
+                     static_cast<std::streamsize>(records_.size() * sizeof(Record)));
+            for (auto text: strings_) {
+                auto size = static_cast<std::uint32_t>(text.size());
+                os.write(reinterpret_cast<const char *>(&size), sizeof(size));
+                os.write(text.data(), static_cast<std::streamsize>(text.size()));
+            }
+        });
+    }
+} // namespace TinyCobalt::LexerParser
@@ -0,0 +1,85 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_SRC_LEXERPARSER_TOKENCACHE_H_
+#define TINY_COBALT_SRC_LEXERPARSER_TOKENCACHE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Common/Symbol.h"
+#include "LexerParser/Location.h"
+#include "LexerParser/Parser.h"
+#include "LexerParser/SourceBuffer.h"
+#include "Parser.tab.hpp"
+
+namespace TinyCobalt::LexerParser {
+    /**
+     * The token stream of one source text, stored in a flat binary file named after a hash of the text. A hit
+     * replays the tokens without running a scanner; a miss records the tokens produced by the scanner so that they
+     * can be stored after a successful parse.
+     *
+     * The file is a header followed by the digest of the scanner sources, one fixed-size record per token and the
+     * string table. Records hold the token kind, the offsets relative to the start of the text and the payload: a
+     * string table index for names and strings, or the decoded value for other literals. A file is replayed only if
+     * it was written by the same scanners for a text of the same size and the same 128-bit hash, so a changed lexer
+     * rule is a miss; the text itself is not stored. Files use the host byte order and are not portable.
+     */
+    class TokenCache {
+    public:
+        using Hash = std::array<std::uint64_t, 2>;
+
+        /**
+         * Look up the cache file for text in dir. text starts at offset base, and names are interned into the pool of
+         * the driver. Return true if the tokens can be replayed; otherwise the cache records the tokens instead.
+         */
+        bool open(const std::string &dir, std::span<const char> text, SourceOffset base, YaccDriver &driver);
+
+        bool replaying() const { return replaying_; }
+
+        // Replay the next token. Past the end of the stream, return end of file.
+        yy::parser::symbol_type next(YaccDriver &driver);
+
+        // Append a token produced by the scanner.
+        void record(const yy::parser::symbol_type &token);
+
+        /**
+         * Write the recorded tokens, which must be the complete stream of the text. The file is replaced atomically,
+         * so concurrent writers of the same text are harmless. Return false if the file cannot be written.
+         */
+        bool store() const;
+
+    private:
+        // No implicit padding, so that files are deterministic.
+        struct Record {
+            std::uint64_t payload;
+            std::uint32_t begin;
+            std::uint32_t end;
+            std::uint32_t kind;
+            std::uint32_t reserved;
+        };
+
+        bool load(const SourceBuffer &file, YaccDriver &driver);
+        std::uint32_t addString(std::string_view text);
+
+        std::string file_;
+        std::size_t size_ = 0;
+        Hash hash_{};
+        SourceOffset base_ = 0;
+        bool replaying_ = false;
+        std::vector<Record> records_;
+        std::size_t cursor_ = 0;
+        // Replay: the interned strings. Record: the string table and an index for deduplication.
+        std::vector<Common::Symbol> symbols_;
+        std::vector<std::string_view> strings_;
+        std::unordered_map<std::string_view, std::uint32_t> string_index_;
+    };
+} // namespace TinyCobalt::LexerParser
+
+#endif // TINY_COBALT_SRC_LEXERPARSER_TOKENCACHE_H_
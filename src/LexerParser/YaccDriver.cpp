@@ -4,6 +4,9 @@
 
 #include "LexerParser/YaccDriver.h"
 #include <cassert>
+#include <sstream>
+#include "DirectLexer.h"
+#include "TokenCache.h"
 #include "Parser.tab.hpp"
 
 namespace TinyCobalt::LexerParser {
@@ -11,14 +14,118 @@ namespace TinyCobalt::LexerParser {
     YaccDriver::YaccDriver(std::istream *is, std::ostream *os) : is(is), os(os) {}
 
     int YaccDriver::parse() {
-        assert(this->is);
+        assert(this->is || this->span || this->mapFile);
+        // The previous tree, if any, keeps its own arena.
+        this->arena = Common::makeArena(this->symbols);
+        this->result = nullptr;
+        this->topLevelLocations.clear();
+        this->diagnostics.clear();
         this->scan_begin();
 
         yy::parser parser(*this);
+#if YYDEBUG
         parser.set_debug_level(trace_parsing);
+#endif
         int res = parser.parse();
+        // Only a successful parse has read the whole token stream.
+        if (tokenCache && !tokenCache->replaying() && res == 0 && diagnostics.empty())
+            tokenCache->store();
+        if (result) {
+            result->resources.emplace_back(symbols);
+            result->resources.emplace_back(arena);
+        }
 
         this->scan_end();
-        return res;
+        // Recovered errors do not fail the bison parser.
+        return res != 0 ? res : !diagnostics.empty();
+    }
+
+    std::size_t YaccDriver::lex() {
+        assert(this->is || this->span || this->mapFile);
+        this->scan_begin();
+        std::size_t count = 0;
+        try {
+            while (nextToken(*this).kind() != yy::parser::symbol_kind::S_YYEOF)
+                ++count;
+        } catch (...) {
+            this->scan_end();
+            throw;
+        }
+        this->scan_end();
+        return count;
+    }
+
+    std::string YaccDriver::describe(const Location &loc) const {
+        if (this->sources)
+            return this->sources->format(loc);
+        std::ostringstream os;
+        os << loc;
+        return os.str();
+    }
+
+    namespace {
+        yy::parser::symbol_type scanToken(YaccDriver &driver) {
+            if (driver.tokenCache && driver.tokenCache->replaying())
+                return driver.tokenCache->next(driver);
+            auto token = driver.lexerKind == LexerKind::Direct ? driver.directLexer->yylex(driver)
+                                                               : driver.lexer->yylex(driver);
+            if (driver.tokenCache)
+                driver.tokenCache->record(token);
+            return token;
+        }
+
+        // Whether "<" after a token of this kind opens a template argument list. Types never appear as operands, so
+        // this is decided by the previous token alone.
+        bool opensTemplate(int kind) {
+            using Kind = yy::parser::symbol_kind;
+            return kind == Kind::S_TYPENAME || kind == Kind::S_STATIC_CAST || kind == Kind::S_CONST_CAST ||
+                   kind == Kind::S_REINTERPRET_CAST;
+        }
+    } // namespace
+
+    yy::parser::symbol_type nextToken(YaccDriver &driver) {
+        using Kind = yy::parser::symbol_kind;
+        if (driver.pendingGreater) {
+            auto loc = *driver.pendingGreater;
+            driver.pendingGreater.reset();
+            driver.lastTokenKind = Kind::S_GREATER;
+            if (driver.templateDepth > 0)
+                --driver.templateDepth;
+            return yy::parser::make_GREATER(loc);
+        }
+
+        auto token = scanToken(driver);
+        int kind = token.kind();
+        switch (kind) {
+            case Kind::S_LESS:
+                if (opensTemplate(driver.lastTokenKind))
+                    ++driver.templateDepth;
+                break;
+            case Kind::S_GREATER:
+                if (driver.templateDepth > 0)
+                    --driver.templateDepth;
+                break;
+            case Kind::S_RSHIFT:
+                // Inside a template argument list, ">>" is two closing ">", as in C++11. Hand out the first one now
+                // and the second one on the next call, so the scanners never need to look back.
+                if (driver.templateDepth > 0) {
+                    const auto &loc = token.location;
+                    driver.pendingGreater = Location(loc.begin + 1, loc.end);
+                    driver.lastTokenKind = Kind::S_GREATER;
+                    --driver.templateDepth;
+                    return yy::parser::make_GREATER(Location(loc.begin, loc.begin + 1));
+                }
+                break;
+            case Kind::S_SEMICOLON:
+            case Kind::S_LBRACE:
+            case Kind::S_RBRACE:
+                // Argument lists never span these. Resetting keeps an unclosed list after a syntax error local.
+                driver.templateDepth = 0;
+                break;
+            default:
+                break;
+        }
+        driver.lastTokenKind = kind;
+        return token;
     }
 } // namespace TinyCobalt::LexerParser
\ No newline at end of file
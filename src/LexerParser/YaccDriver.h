@@ -5,7 +5,9 @@
 #ifndef TINY_COBALT_SRC_LEXERPARSER_YACCDRIVER_H_
 #define TINY_COBALT_SRC_LEXERPARSER_YACCDRIVER_H_
 
+#include <cstddef>
 #include <proxy.h>
+#include <span>
 
 #include "LexerParser/Parser.h"
 #include "Parser.tab.hpp"
@@ -16,9 +18,24 @@
 namespace TinyCobalt::LexerParser {
     class YaccLexer : public yyFlexLexer {
     public:
+        YaccLexer() = default;
+        // Read the input directly from memory instead of the stream set by switch_streams.
+        explicit YaccLexer(std::span<const char> source) : source_(source), from_memory_(true) {}
+
         yy::parser::symbol_type yylex(YaccDriver &driver);
+
+    protected:
+        int LexerInput(char *buf, int max_size) override;
+
+    private:
+        std::span<const char> source_;
+        std::size_t cursor_ = 0;
+        bool from_memory_ = false;
     };
 
+    // Fetch the next token from the scanner selected by driver.lexerKind.
+    yy::parser::symbol_type nextToken(YaccDriver &driver);
+
 } // namespace TinyCobalt::LexerParser
 
 #endif // TINY_COBALT_SRC_LEXERPARSER_YACCDRIVER_H_
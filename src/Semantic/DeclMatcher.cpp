@@ -18,7 +18,7 @@ namespace TinyCobalt::Semantic {
         if (current_alias_->getSymbol(ptr->name) != nullptr // NOLINT
             || current_struct_->getSymbol(ptr->name) != nullptr // NOLINT
             || current_variable_->getSymbol(ptr->name) != nullptr) {
-            throw std::runtime_error("Symbol " + ptr->name + " already exists");
+            throw std::runtime_error("Symbol " + ptr->name.str() + " already exists");
         }
         current_func_->addSymbol(ptr->name, ptr);
     }
@@ -27,7 +27,7 @@ namespace TinyCobalt::Semantic {
         if (current_alias_->getSymbol(ptr->name) != nullptr // NOLINT
             || current_struct_->getSymbol(ptr->name) != nullptr // NOLINT
             || current_func_->getSymbol(ptr->name) != nullptr) {
-            throw std::runtime_error("Symbol " + ptr->name + " already exists");
+            throw std::runtime_error("Symbol " + ptr->name.str() + " already exists");
         }
         current_variable_->addSymbol(ptr->name, ptr);
     }
@@ -36,7 +36,7 @@ namespace TinyCobalt::Semantic {
         if (current_func_->getSymbol(ptr->name) != nullptr // NOLINT
             || current_struct_->getSymbol(ptr->name) != nullptr // NOLINT
             || current_variable_->getSymbol(ptr->name) != nullptr) {
-            throw std::runtime_error("Symbol " + ptr->name + " already exists");
+            throw std::runtime_error("Symbol " + ptr->name.str() + " already exists");
         }
         current_alias_->addSymbol(ptr->name, ptr);
     }
@@ -45,7 +45,7 @@ namespace TinyCobalt::Semantic {
         if (current_alias_->getSymbol(ptr->name) != nullptr // NOLINT
             || current_func_->getSymbol(ptr->name) != nullptr // NOLINT
             || current_variable_->getSymbol(ptr->name) != nullptr) {
-            throw std::runtime_error("Symbol " + ptr->name + " already exists");
+            throw std::runtime_error("Symbol " + ptr->name.str() + " already exists");
         }
         current_struct_->addSymbol(ptr->name, ptr);
     }
@@ -62,7 +62,7 @@ namespace TinyCobalt::Semantic {
                 [&](AST::SimpleTypePtr ptr) { ptr->def = findType(ptr->name); },
                 [&](AST::FuncDefPtr ptr) {
                     tryAddSymbol(ptr);
-                    next_scope_name_ = ptr->name;
+                    next_scope_name_ = ptr->name.str();
                 },
                 [&](AST::BlockPtr ptr) {
                     pushScope(next_scope_name_);
@@ -80,12 +80,12 @@ namespace TinyCobalt::Semantic {
         return AST::VisitorState::Normal;
     }
     
-    AST::SimpleTypeNode::TypeDefPtr DeclMatcher::findType(const std::string &name) {
+    AST::SimpleTypeNode::TypeDefPtr DeclMatcher::findType(const Common::Symbol &name) {
         if (auto alias = current_alias_->getSymbol(name))
             return alias;
         if (auto struc = current_struct_->getSymbol(name))
             return struc;
-        if (auto builtin = AST::BuiltInType::findType(name))
+        if (auto builtin = AST::BuiltInType::findType(name.view()))
             return builtin;
         // throw std::runtime_error("Type " + name + " not found");
         return nullptr;
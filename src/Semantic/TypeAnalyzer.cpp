@@ -13,18 +13,6 @@
 #include "Common/Utility.h"
 
 namespace TinyCobalt::Semantic {
-    static auto kTemplateArgMatcher = Matcher{[](AST::TypeNodePtr node) { return node; },
-                                              [](AST::ConstExprPtr node) { return AST::TypeNodePtr{nullptr}; }};
-
-    AST::TypeNodePtr pointerTo(AST::TypeNodePtr ptr) {
-        if (proxy_typeid(ptr).hash_code() != typeid(AST::ComplexTypePtr).hash_code())
-            return nullptr;
-        auto cplx = proxy_cast<AST::ComplexTypePtr>(ptr);
-        if (cplx->templateName != "Pointer")
-            return nullptr;
-        return std::visit(kTemplateArgMatcher, cplx->templateArgs.front());
-    }
-
     AST::VisitorState TypeAnalyzer::afterSubtreeImpl(AST::ASTNodePtr node) {
         auto matcher = Matcher{
 #define REG_ANALYZER(Name, ...) [&](AST::Name##Ptr node) { return analyzeType(node); },
@@ -40,25 +28,23 @@ namespace TinyCobalt::Semantic {
             case AST::ConstExprType::HexInt:
             case AST::ConstExprType::OctInt:
             case AST::ConstExprType::BinInt: {
-                ptr->exprType() = AST::BuiltInType::findType("int");
+                ptr->exprType() = types_.simple("int");
                 break;
             }
             case AST::ConstExprType::Float: {
-                ptr->exprType() = AST::BuiltInType::findType("float");
+                ptr->exprType() = types_.simple("float");
                 break;
             }
             case AST::ConstExprType::Bool: {
-                ptr->exprType() = AST::BuiltInType::findType("bool");
+                ptr->exprType() = types_.simple("bool");
                 break;
             }
             case AST::ConstExprType::String: {
-                ptr->exprType() = std::make_shared<AST::ComplexTypeNode>(
-                        "Pointer",
-                        std::vector{AST::ComplexTypeNode::TemplateArgType(AST::BuiltInType::findType("char"))});
+                ptr->exprType() = types_.pointer(types_.simple("char"));
                 break;
             }
             case AST::ConstExprType::Char: {
-                ptr->exprType() = AST::BuiltInType::findType("char");
+                ptr->exprType() = types_.simple("char");
                 break;
             }
         }
@@ -67,9 +53,9 @@ namespace TinyCobalt::Semantic {
 
     AST::VisitorState TypeAnalyzer::analyzeType(AST::VariablePtr ptr) {
         if (ptr->def == nullptr) {
-            throw std::runtime_error("Variable " + ptr->name + " is not defined");
+            throw std::runtime_error("Variable " + ptr->name.str() + " is not defined");
         }
-        ptr->exprType() = ptr->def->type;
+        ptr->exprType() = types_.intern(ptr->def->type);
         return AST::VisitorState::Normal;
     }
 
@@ -86,7 +72,7 @@ namespace TinyCobalt::Semantic {
             case AST::BinaryOp::BitLShift:
             case AST::BinaryOp::BitRShift: {
                 // TODO: unsigned int support
-                ptr->exprType() = AST::BuiltInType::findType("int");
+                ptr->exprType() = types_.simple("int");
                 break;
             }
             case AST::BinaryOp::And:
@@ -97,7 +83,7 @@ namespace TinyCobalt::Semantic {
             case AST::BinaryOp::Greater:
             case AST::BinaryOp::Leq:
             case AST::BinaryOp::Geq: {
-                ptr->exprType() = AST::BuiltInType::findType("bool");
+                ptr->exprType() = types_.simple("bool");
                 break;
             }
             case AST::BinaryOp::Assign: {
@@ -115,9 +101,9 @@ namespace TinyCobalt::Semantic {
             case AST::BinaryOp::BitXorAssign:
             case AST::BinaryOp::BitLShiftAssign:
             case AST::BinaryOp::BitRShiftAssign: {
-                TINY_COBALT_ASSERT(ptr->exprType()->convertibleTo(AST::BuiltInType::findType("int")),
+                TINY_COBALT_ASSERT(TypeContext::same(ptr->lhs->exprType(), types_.simple("int")),
                                    "No valid operator for the operand.");
-                ptr->exprType() = AST::BuiltInType::findType("int");
+                ptr->exprType() = types_.simple("int");
             }
             // TODO: remove this case
             case AST::BinaryOp::Member:
@@ -136,21 +122,19 @@ namespace TinyCobalt::Semantic {
             case AST::UnaryOp::PreDec:
             case AST::UnaryOp::PostInc:
             case AST::UnaryOp::PostDec: {
-                ptr->exprType() = AST::BuiltInType::findType("int");
+                ptr->exprType() = types_.simple("int");
                 break;
             }
             case AST::UnaryOp::Not: {
-                ptr->exprType() = AST::BuiltInType::findType("bool");
+                ptr->exprType() = types_.simple("bool");
                 break;
             }
             case AST::UnaryOp::Addr: {
-                ptr->exprType() = pointerTo(ptr->operand->exprType());
+                ptr->exprType() = types_.pointee(ptr->operand->exprType());
                 break;
             }
             case AST::UnaryOp::Deref: {
-                auto t = ptr->operand->exprType();
-                ptr->exprType() = std::make_shared<AST::ComplexTypeNode>(
-                        "Pointer", std::vector{AST::ComplexTypeNode::TemplateArgType(t)});
+                ptr->exprType() = types_.pointer(ptr->operand->exprType());
                 break;
             }
         }
@@ -161,15 +145,10 @@ namespace TinyCobalt::Semantic {
         switch (ptr->op) {
             case AST::MultiaryOp::Subscript: {
                 // TODO: Implement type analyzer for subscript overload
-                auto def = ptr->object->exprType();
                 TINY_COBALT_ASSERT(ptr->operands.size() == 1 && pointerType<AST::ConstExprPtr>(ptr->operands.front()),
                                    "Invalid subscript");
-                TINY_COBALT_ASSERT(pointerType<AST::ComplexTypePtr>(def), "Not a pointer or array");
-                auto cplx = proxy_cast<AST::ComplexTypePtr>(def);
-                TINY_COBALT_ASSERT(cplx->templateName == "Pointer" || cplx->templateName == "Array",
-                                   "Not a pointer or array");
-                ptr->exprType() = std::visit(kTemplateArgMatcher, cplx->templateArgs.front());
-                TINY_COBALT_ASSERT(ptr->exprType(), "Invalid subscript");
+                ptr->exprType() = types_.element(ptr->object->exprType());
+                TINY_COBALT_ASSERT(ptr->exprType(), "Not a pointer or array");
                 break;
             }
             case AST::MultiaryOp::FuncCall: {
@@ -177,7 +156,7 @@ namespace TinyCobalt::Semantic {
                 auto def = ptr->object->exprType();
                 TINY_COBALT_ASSERT(pointerType<AST::FuncDefPtr>(def), "Not a function");
                 auto func_def = proxy_cast<AST::FuncDefPtr>(def);
-                ptr->exprType() = func_def->returnType;
+                ptr->exprType() = types_.intern(func_def->returnType);
                 break;
             }
             case AST::MultiaryOp::Comma:
@@ -187,7 +166,7 @@ namespace TinyCobalt::Semantic {
     }
 
     AST::VisitorState TypeAnalyzer::analyzeType(AST::CastPtr ptr) {
-        ptr->exprType() = ptr->type;
+        ptr->exprType() = types_.intern(ptr->type);
         return AST::VisitorState::Normal;
     }
 
@@ -203,7 +182,7 @@ namespace TinyCobalt::Semantic {
         auto struct_def = proxy_cast<AST::StructDefPtr>(def);
         for (auto &x: struct_def->fields) {
             if (x->name == ptr->member) {
-                ptr->exprType() = x->type;
+                ptr->exprType() = types_.intern(x->type);
                 return AST::VisitorState::Normal;
             }
         }
@@ -0,0 +1,149 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "Semantic/TypeContext.h"
+#include <functional>
+#include <memory>
+#include <utility>
+#include <variant>
+#include "Common/Utility.h"
+
+namespace TinyCobalt::Semantic {
+
+    std::size_t TypeContext::KeyHash::operator()(const Key &key) const {
+        std::size_t hash = key.size();
+        for (auto *ptr: key)
+            hash = hash * 31 + std::hash<const void *>{}(ptr);
+        return hash;
+    }
+
+    TypeContext::TypeContext() : pointer_(names_.intern("Pointer")), array_(names_.intern("Array")) {
+        for (auto name: AST::BuiltInType::kNames)
+            simple_.emplace(names_.intern(name).data(), AST::BuiltInType::findType(name));
+    }
+
+    AST::SimpleTypePtr TypeContext::simple(std::string_view name) {
+        auto symbol = names_.intern(name);
+        auto &node = simple_[symbol.data()];
+        if (!node)
+            node = std::make_shared<AST::SimpleTypeNode>(symbol);
+        return node;
+    }
+
+    AST::SimpleTypePtr TypeContext::simple(std::string_view name, const AST::SimpleTypeNode::TypeDefPtr &def) {
+        const void *decl = nullptr;
+        if (auto *alias = std::get_if<AST::AliasDefPtr>(&def))
+            decl = alias->get();
+        else if (auto *struc = std::get_if<AST::StructDefPtr>(&def))
+            decl = struc->get();
+        if (!decl)
+            return simple(name);
+        auto &node = declared_[decl];
+        if (!node) {
+            node = std::make_shared<AST::SimpleTypeNode>(names_.intern(name));
+            node->def = def;
+        }
+        return node;
+    }
+
+    AST::FuncTypePtr TypeContext::func(const AST::TypeNodePtr &returnType,
+                                       const std::vector<AST::TypeNodePtr> &paramTypes) {
+        std::vector<AST::TypeNodePtr> params;
+        params.reserve(paramTypes.size());
+        Key key;
+        key.reserve(paramTypes.size() + 1);
+        auto ret = intern(returnType);
+        key.push_back(ret ? ret->thisPointer() : nullptr);
+        for (const auto &param: paramTypes) {
+            params.push_back(intern(param));
+            key.push_back(params.back() ? params.back()->thisPointer() : nullptr);
+        }
+        auto &node = func_[std::move(key)];
+        if (!node)
+            node = std::make_shared<AST::FuncTypeNode>(std::move(ret), std::move(params));
+        return node;
+    }
+
+    AST::ComplexTypePtr TypeContext::complex(std::string_view name,
+                                             const std::vector<AST::ComplexTypeNode::TemplateArgType> &templateArgs) {
+        auto symbol = names_.intern(name);
+        std::vector<AST::ComplexTypeNode::TemplateArgType> args;
+        args.reserve(templateArgs.size());
+        Key key;
+        key.reserve(templateArgs.size() + 1);
+        key.push_back(symbol.data());
+        for (const auto &arg: templateArgs) {
+            if (auto *type = std::get_if<AST::TypeNodePtr>(&arg)) {
+                auto canonical = intern(*type);
+                key.push_back(canonical ? canonical->thisPointer() : nullptr);
+                args.emplace_back(std::move(canonical));
+            } else {
+                auto canonical = constant(std::get<AST::ConstExprPtr>(arg));
+                key.push_back(canonical.get());
+                args.emplace_back(std::move(canonical));
+            }
+        }
+        auto &node = complex_[std::move(key)];
+        if (!node)
+            node = std::make_shared<AST::ComplexTypeNode>(symbol, std::move(args));
+        return node;
+    }
+
+    AST::ComplexTypePtr TypeContext::pointer(const AST::TypeNodePtr &pointee) {
+        return complex(pointer_.view(), {AST::ComplexTypeNode::TemplateArgType(pointee)});
+    }
+
+    AST::TypeNodePtr TypeContext::intern(const AST::TypeNodePtr &type) {
+        if (!type)
+            return nullptr;
+        if (pointerType<AST::SimpleTypePtr>(type)) {
+            auto node = proxy_cast<AST::SimpleTypePtr>(type);
+            return simple(node->name.view(), node->def);
+        }
+        if (pointerType<AST::FuncTypePtr>(type)) {
+            auto node = proxy_cast<AST::FuncTypePtr>(type);
+            return func(node->returnType, node->paramTypes);
+        }
+        auto node = proxy_cast<AST::ComplexTypePtr>(type);
+        return complex(node->templateName.view(), node->templateArgs);
+    }
+
+    AST::TypeNodePtr TypeContext::pointee(const AST::TypeNodePtr &type) const {
+        auto node = typeArgument(type, pointer_);
+        // Pointer takes exactly one argument.
+        if (!node || proxy_cast<AST::ComplexTypePtr>(type)->templateArgs.size() != 1)
+            return nullptr;
+        return node;
+    }
+
+    AST::TypeNodePtr TypeContext::element(const AST::TypeNodePtr &type) const {
+        if (auto node = pointee(type))
+            return node;
+        return typeArgument(type, array_);
+    }
+
+    AST::TypeNodePtr TypeContext::typeArgument(const AST::TypeNodePtr &type, const Common::Symbol &name) const {
+        if (!type || !pointerType<AST::ComplexTypePtr>(type))
+            return nullptr;
+        auto node = proxy_cast<AST::ComplexTypePtr>(type);
+        // Canonical names come from names_, so they are recognized by address.
+        if (node->templateName.data() != name.data() || node->templateArgs.empty())
+            return nullptr;
+        auto *arg = std::get_if<AST::TypeNodePtr>(&node->templateArgs.front());
+        return arg ? *arg : nullptr;
+    }
+
+    AST::ConstExprPtr TypeContext::constant(const AST::ConstExprPtr &expr) {
+        auto key = std::string(magic_enum::enum_name(expr->type)) + ':' + expr->text();
+        auto &node = constants_[std::move(key)];
+        if (!node) {
+            auto value = expr->value;
+            if (auto *text = std::get_if<Common::Symbol>(&value))
+                *text = names_.intern(text->view());
+            node = std::make_shared<AST::ConstExprNode>(expr->type, std::move(value));
+        }
+        return node;
+    }
+
+} // namespace TinyCobalt::Semantic
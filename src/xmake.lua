@@ -19,6 +19,24 @@ target("tiny-cobalt-library")
     add_defines("TINYCOBALT_LIBRARY")
     add_defines("TINYCOBALT_ENABLE_JSON")
     add_files("**.cpp", "**.yy", "**.ll")
+    -- Scanner and parser traces and the bison variant assertions only exist in debug builds. NDEBUG is public so that
+    -- the targets using the library see the same inline asserts of its headers.
+    if is_mode("debug") then
+        add_defines("TINYCOBALT_ENABLE_TRACE", { public = true })
+        add_values("lex.flags", "--debug")
+        add_values("yacc.flags", "-Dparse.assert")
+    else
+        add_defines("NDEBUG", { public = true })
+    end
+    -- Token caches are keyed by the sources that decide the token stream, so that other lexer rules never replay them.
+    on_config(function (target)
+        local digests = {}
+        local sources = {"Lexer.ll", "Parser.yy", "DirectLexer.h", "DirectLexer.cpp", "Keywords.cpp", "Literals.cpp"}
+        for _, file in ipairs(sources) do
+            table.insert(digests, hash.sha256(path.join(target:scriptdir(), "LexerParser", file)))
+        end
+        target:add("defines", "TINYCOBALT_LEXER_DIGEST=\"" .. table.concat(digests, ":") .. "\"")
+    end)
     add_includedirs("$(projectdir)/include", { public = true })
     add_includedirs("$(projectdir)/src", { public = false })
     add_headerfiles("**.h")
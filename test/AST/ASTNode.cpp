@@ -3,6 +3,9 @@
 //
 
 #include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include "AST/AST.h"
 #include "AST/ASTNodeDecl.h"
 #include "AST/ExprNode.h"
@@ -12,7 +15,7 @@ using namespace TinyCobalt::AST;
 using TinyCobalt::Common::JSON;
 
 TEST(ASTNode, ExprNode1) {
-    auto const_expr = std::make_shared<ConstExprNode>("1", ConstExprType::Int);
+    auto const_expr = std::make_shared<ConstExprNode>(ConstExprType::Int, "1");
     auto variable = std::make_shared<VariableNode>("x");
     auto binary1 = std::make_shared<BinaryNode>(const_expr, BinaryOp::Mul, const_expr);
     auto binary2 = std::make_shared<BinaryNode>(variable, BinaryOp::Add, binary1);
@@ -51,3 +54,65 @@ TEST(ASTNode, ExprNode1) {
     JSON res = ast->toJSON();
     EXPECT_EQ(res, exp);
 }
+
+TEST(ASTNode, ConstExprValue) {
+    EXPECT_EQ(std::get<std::uint64_t>(ConstExprNode(ConstExprType::Int, "42").value), 42u);
+    EXPECT_EQ(std::get<std::uint64_t>(ConstExprNode(ConstExprType::HexInt, "0x1F").value), 31u);
+    EXPECT_EQ(std::get<std::uint64_t>(ConstExprNode(ConstExprType::OctInt, "0o17").value), 15u);
+    EXPECT_EQ(std::get<std::uint64_t>(ConstExprNode(ConstExprType::BinInt, "0b101").value), 5u);
+    EXPECT_EQ(std::get<double>(ConstExprNode(ConstExprType::Float, ".5").value), 0.5);
+    EXPECT_EQ(std::get<char>(ConstExprNode(ConstExprType::Char, "'c'").value), 'c');
+    EXPECT_EQ(std::get<bool>(ConstExprNode(ConstExprType::Bool, "false").value), false);
+    EXPECT_EQ(std::get<TinyCobalt::Common::Symbol>(ConstExprNode(ConstExprType::String, "\"s\"").value), "\"s\"");
+
+    EXPECT_EQ(ConstExprNode(ConstExprType::HexInt, "0x1F").text(), "0x1f");
+    EXPECT_EQ(ConstExprNode(ConstExprType::OctInt, "0o017").text(), "0o17");
+    EXPECT_EQ(ConstExprNode(ConstExprType::Float, "1.50").text(), "1.5");
+    EXPECT_EQ(ConstExprNode(ConstExprType::Float, "2.0").text(), "2.0");
+    EXPECT_EQ(ConstExprNode(ConstExprType::Int, std::uint64_t{7}).text(), "7");
+
+    EXPECT_EQ(std::get<std::uint64_t>(ConstExprNode(ConstExprType::Int, "18446744073709551615").value),
+              18446744073709551615u);
+    EXPECT_THROW(ConstExprNode(ConstExprType::Int, "18446744073709551616"), std::out_of_range);
+    EXPECT_THROW(ConstExprNode(ConstExprType::HexInt, "0x"), std::invalid_argument);
+}
+
+TEST(ASTNode, ChildAccess) {
+    auto variable = std::make_shared<VariableNode>("x");
+    std::vector<ExprNodePtr> args{variable, variable};
+    auto call = std::make_shared<MultiaryNode>(MultiaryOp::FuncCall, variable, args);
+    auto stmt = std::make_shared<IfNode>(call, std::make_shared<ExprStmtNode>(call), nullptr);
+    ASTNodePtr ast = stmt;
+    ASSERT_EQ(ast->childCount(), 3u);
+    EXPECT_FALSE(ast->child(2));
+    std::size_t index = 0;
+    for (auto child: ast->traverse()) {
+        ASSERT_LT(index, ast->childCount());
+        EXPECT_EQ(child.has_value(), ast->child(index).has_value());
+        ++index;
+    }
+    EXPECT_EQ(index, ast->childCount());
+    EXPECT_THROW(ast->child(3), std::out_of_range);
+
+    ASTNodePtr multiary = call;
+    ASSERT_EQ(multiary->childCount(), 3u);
+    EXPECT_EQ(multiary->child(1)->toJSON(), variable->toJSON());
+    EXPECT_EQ(ASTNodePtr(variable)->childCount(), 0u);
+}
+
+TEST(ASTNode, Kind) {
+    auto variable = std::make_shared<VariableNode>("x");
+    auto param = std::make_shared<FuncDefNode::ParamsElemNode>(BuiltInType::findType("int"), "a");
+    EXPECT_EQ(ASTNodePtr(variable)->kind(), NodeKind::Variable);
+    EXPECT_EQ(ASTNodePtr(param)->kind(), NodeKind::VariableDef);
+    static_assert(BinaryNode::kKind == NodeKind::Binary);
+    static_assert(ASTRootNode::kKind == NodeKind::ASTRoot);
+
+    int defs = 0, params = 0;
+    auto matcher = TinyCobalt::Matcher{[&](VariableDefPtr) { ++defs; }, // NOLINT
+                                       [&](FuncDefNode::ParamsElem) { ++params; }, // NOLINT
+                                       [&](VariablePtr) { ++defs; }};
+    TinyCobalt::visit(matcher, ASTNodePtr(param));
+    EXPECT_EQ(defs, 0);
+    EXPECT_EQ(params, 1);
+}
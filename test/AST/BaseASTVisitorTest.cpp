@@ -0,0 +1,51 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AST/ASTNodeDecl.h"
+#include "AST/ASTVisitor.h"
+#include "TestUtility.h"
+
+using namespace TinyCobalt;
+using namespace AST;
+using namespace TinyCobalt::Test;
+
+TEST(AST, BaseASTVisitorStates) {
+    BaseASTVisitor<Recorder<>> visitor;
+    EXPECT_EQ(visitor.visit(call({"skip", "cont", "x", "stop", "y"})), VisitorState::Normal);
+    EXPECT_EQ(visitor.middleware().log,
+              "(M [f (f f) f] [skip (skip skip] [cont [x (x x) x] [stop (stop stop) stop] M)");
+
+    visitor.middleware().log.clear();
+    EXPECT_EQ(visitor.visit(call({"x", "exit", "y"})), VisitorState::Exit);
+    EXPECT_EQ(visitor.middleware().log, "(M [f (f f) f] [x (x x) x] [exit (exit");
+
+    // Nothing is left over from the visit that exited.
+    visitor.middleware().log.clear();
+    EXPECT_EQ(visitor.visit(std::make_shared<VariableNode>("x")), VisitorState::Normal);
+    EXPECT_EQ(visitor.middleware().log, "(x x)");
+    EXPECT_EQ(visitor.visit(nullptr), VisitorState::EmptyNode);
+}
+
+TEST(AST, BaseASTVisitorDeepTree) {
+    constexpr std::size_t kDepth = 200000;
+    std::vector<UnaryPtr> chain;
+    chain.reserve(kDepth);
+    ExprNodePtr expr = std::make_shared<VariableNode>("x");
+    for (std::size_t i = 0; i < kDepth; ++i) {
+        chain.push_back(std::make_shared<UnaryNode>(UnaryOp::Negative, expr));
+        expr = chain.back();
+    }
+    BaseASTVisitor<Counter> visitor;
+    EXPECT_EQ(visitor.visit(expr), VisitorState::Normal);
+    EXPECT_EQ(visitor.middleware().nodes, kDepth + 1);
+    // Node destructors recurse through the chain, so it is released from the root down, one node at a time.
+    expr = nullptr;
+    while (!chain.empty())
+        chain.pop_back();
+}
@@ -0,0 +1,118 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "AST/BinaryAST.h"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "AST/AST.h"
+#include "AST/ASTVisitor.h"
+#include "AST/FlatAST.h"
+#include "LexerParser/SourceBuffer.h"
+#include "TestUtility.h"
+
+using namespace TinyCobalt;
+using namespace TinyCobalt::Test;
+
+TEST(AST, BinaryASTRoundTrip) {
+    auto root = parse(kProgram);
+    AST::FlatAST flat(root);
+    AST::BinaryAST binary{LexerParser::SourceBuffer(AST::BinaryAST::serialize(flat))};
+    ASSERT_EQ(binary.size(), flat.size());
+    for (AST::NodeId id = 0; id < flat.size(); ++id) {
+        EXPECT_EQ(binary.kind(id), flat.kind(id));
+        EXPECT_EQ(binary.location(id).begin, flat.location(id).begin);
+        EXPECT_EQ(binary.location(id).end, flat.location(id).end);
+    }
+    auto restored = binary.materialize();
+    EXPECT_EQ(restored->toJSON(), root->toJSON());
+    // Names are stored once.
+    EXPECT_LT(binary.strings(), flat.size() / 2);
+}
+
+TEST(AST, BinaryASTNodes) {
+    auto root = parse(kProgram);
+    AST::FlatAST flat(root);
+    AST::BinaryAST binary{LexerParser::SourceBuffer(AST::BinaryAST::serialize(flat))};
+    EXPECT_EQ(binary.root()->toJSON(), root->toJSON());
+    for (AST::NodeId id = 0; id < flat.size(); ++id) {
+        auto node = binary.node(id);
+        auto expected = flat.node(id);
+        EXPECT_EQ(node->kind(), expected->kind());
+        EXPECT_EQ(node->toJSON(), expected->toJSON());
+        ASSERT_EQ(node->childCount(), expected->childCount());
+        for (std::size_t i = 0; i < node->childCount(); ++i) {
+            auto child = node->child(i);
+            auto expected_child = expected->child(i);
+            ASSERT_EQ(static_cast<bool>(child), static_cast<bool>(expected_child));
+            if (child)
+                EXPECT_EQ(child->kind(), expected_child->kind());
+        }
+        EXPECT_THROW(node->child(node->childCount()), std::out_of_range);
+    }
+}
+
+TEST(AST, BinaryASTWideRoot) {
+    // Each child of a node is found in constant time. If finding one decoded the list up to it, this visit would
+    // take billions of steps.
+    constexpr std::size_t kWidth = 100000;
+    std::vector<AST::StmtNodePtr> stmts;
+    stmts.reserve(kWidth);
+    for (std::size_t i = 0; i < kWidth; ++i)
+        stmts.push_back(std::make_shared<AST::ExprStmtNode>(std::make_shared<AST::VariableNode>("x")));
+    AST::FlatAST flat(std::make_shared<AST::ASTRootNode>(std::move(stmts)));
+    AST::BinaryAST binary{LexerParser::SourceBuffer(AST::BinaryAST::serialize(flat))};
+    ASSERT_EQ(binary.root()->childCount(), kWidth);
+    EXPECT_EQ(binary.root()->child(kWidth - 1)->kind(), AST::NodeKind::ExprStmt);
+    AST::BaseASTVisitor<Counter> visitor;
+    EXPECT_EQ(visitor.visit(binary.root()), AST::VisitorState::Normal);
+    EXPECT_EQ(visitor.middleware().nodes, 2 * kWidth + 1);
+}
+
+TEST(AST, BinaryASTFile) {
+    auto root = parse(kProgram);
+    AST::FlatAST flat(root);
+    auto dir = std::filesystem::temp_directory_path() / "tiny-cobalt-binary-ast-test";
+    std::filesystem::remove_all(dir);
+    auto path = (dir / "module.ast").string();
+    ASSERT_TRUE(AST::BinaryAST::store(flat, path));
+    auto binary = AST::BinaryAST::map(path);
+    EXPECT_EQ(binary.materialize()->toJSON(), root->toJSON());
+    std::filesystem::remove_all(dir);
+}
+
+TEST(AST, BinaryASTMalformed) {
+    AST::FlatAST flat(parse("int a = 1 + 2;"));
+    auto bytes = AST::BinaryAST::serialize(flat);
+    auto truncated = bytes;
+    truncated.resize(truncated.size() - 1);
+    EXPECT_THROW(AST::BinaryAST{LexerParser::SourceBuffer(truncated)}, std::runtime_error);
+    auto bad_magic = bytes;
+    bad_magic[0] = 'X';
+    EXPECT_THROW(AST::BinaryAST{LexerParser::SourceBuffer(bad_magic)}, std::runtime_error);
+    // A bad kind tag in the last record is only found when the record is read.
+    auto bad_kind = bytes;
+    AST::BinaryAST valid{LexerParser::SourceBuffer(bytes)};
+    auto offset = bytes.size() - valid.record(valid.size() - 1).size();
+    bad_kind[offset] = static_cast<char>(0xff);
+    AST::BinaryAST corrupt{LexerParser::SourceBuffer(std::move(bad_kind))};
+    EXPECT_THROW(corrupt.materialize(), std::runtime_error);
+    // Point the left operand of 1 + 2 back at the definition that holds it.
+    AST::NodeId binary = 0;
+    while (valid.kind(binary) != AST::NodeKind::Binary)
+        ++binary;
+    AST::NodeId def = binary + 1;
+    ASSERT_EQ(valid.kind(def), AST::NodeKind::VariableDef);
+    auto cyclic = bytes;
+    offset = bytes.size() - valid.record(binary).size() + 1;
+    // Skip the location and the operator, which are single-byte varints in this small tree.
+    offset += 3;
+    cyclic[offset] = 1; // zigzag(binary - def) == zigzag(-1)
+    AST::BinaryAST cycle{LexerParser::SourceBuffer(std::move(cyclic))};
+    EXPECT_THROW(cycle.materialize(), std::runtime_error);
+}
@@ -0,0 +1,60 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "AST/FlatAST.h"
+#include <gtest/gtest.h>
+#include "AST/AST.h"
+#include "Common/JSON.h"
+#include "TestUtility.h"
+
+using namespace TinyCobalt;
+using namespace TinyCobalt::Test;
+
+namespace {
+    std::size_t countNodes(const AST::ASTNodePtr &node) {
+        std::size_t res = 1;
+        for (auto child: node->traverse())
+            if (child)
+                res += countNodes(child);
+        return res;
+    }
+} // namespace
+
+TEST(AST, FlatASTJSON) {
+    auto root = parse(kProgram);
+    AST::FlatAST flat(root);
+    EXPECT_EQ(flat.root()->toJSON(), root->toJSON());
+    EXPECT_EQ(flat.size(), countNodes(root));
+    EXPECT_EQ(countNodes(flat.root()), flat.size());
+}
+
+TEST(AST, FlatASTAppend) {
+    auto root = parse(kProgram);
+    AST::FlatAST flat;
+    for (const auto &stmt: root->children)
+        flat.append(stmt);
+    flat.resources = root->resources;
+    ASSERT_EQ(flat.children().size(), root->children.size());
+    EXPECT_EQ(flat.root()->toJSON(), root->toJSON());
+    for (std::size_t i = 0; i < root->children.size(); ++i)
+        EXPECT_EQ(flat.node(flat.children()[i])->toJSON(), root->children[i]->toJSON());
+}
+
+TEST(AST, FlatASTRecords) {
+    auto root = parse("int a = 1 + 2;");
+    AST::FlatAST flat(root);
+    auto def = flat.children()[0];
+    ASSERT_EQ(flat.kind(def), AST::NodeKind::VariableDef);
+    const auto &record = flat.getVariableDef(def);
+    EXPECT_EQ(record.name, "a");
+    ASSERT_EQ(flat.kind(record.init), AST::NodeKind::Binary);
+    const auto &binary = flat.getBinary(record.init);
+    EXPECT_EQ(binary.op, AST::BinaryOp::Add);
+    EXPECT_EQ(std::get<std::uint64_t>(flat.getConstExpr(binary.lhs).value), 1u);
+    EXPECT_EQ(std::get<std::uint64_t>(flat.getConstExpr(binary.rhs).value), 2u);
+    // Children get their ids before their parent.
+    EXPECT_LT(binary.lhs, record.init);
+    EXPECT_LT(record.init, def);
+    EXPECT_GT(flat.memoryUsage(), 0u);
+}
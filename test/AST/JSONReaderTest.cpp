@@ -0,0 +1,54 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "AST/JSONReader.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include "AST/AST.h"
+#include "AST/JSONWriter.h"
+#include "TestUtility.h"
+
+using namespace TinyCobalt;
+using namespace TinyCobalt::Test;
+
+TEST(AST, JSONReaderRoundTrip) {
+    auto root = parse(kProgram);
+    auto json = root->toJSON();
+    EXPECT_EQ(json["children"][1]["type"], "AliasDef");
+    std::ostringstream os;
+    AST::JSONWriter(os).write(root);
+    EXPECT_EQ(AST::JSONReader::read(os.str())->toJSON(), json);
+    std::istringstream is(json.dump(2));
+    EXPECT_EQ(AST::JSONReader::read(is)->toJSON(), json);
+    EXPECT_EQ(Common::fromJSON<AST::ASTRootPtr>(json)->toJSON(), json);
+
+    // Parameters and fields get their own node types.
+    auto restored = AST::JSONReader::read(os.str());
+    auto func = proxy_cast<AST::FuncDefPtr>(restored->children[2]);
+    EXPECT_EQ(func->params.size(), 2u);
+    EXPECT_EQ(func->params[1]->name, "b");
+    auto point = proxy_cast<AST::StructDefPtr>(restored->children[0]);
+    EXPECT_EQ(point->fields[0]->name, "x");
+}
+
+TEST(AST, JSONReaderMalformed) {
+    EXPECT_THROW(AST::JSONReader::read(R"({"children": [], "type": "ASTRoot")"), std::runtime_error);
+    EXPECT_THROW(AST::JSONReader::read(R"({"children": [], "type": "Block"})"), std::runtime_error);
+    EXPECT_THROW(AST::JSONReader::read(R"({"children": [], "type": "ASTRoot", "extra": 1})"), std::runtime_error);
+    EXPECT_THROW(AST::JSONReader::read(R"({"children": [{"type": "Break", "type": "Break"}], "type": "ASTRoot"})"),
+                 std::runtime_error);
+    EXPECT_THROW(AST::JSONReader::read(R"({"children": [{"expr": null, "type": "Loop"}], "type": "ASTRoot"})"),
+                 std::runtime_error);
+    EXPECT_THROW(AST::JSONReader::read(
+                         R"({"children": [{"expr": {"expr_type": "Int", "type": "ConstExpr", "value": "x"}, )"
+                         R"("type": "ExprStmt"}], "type": "ASTRoot"})"),
+                 std::runtime_error);
+    // An alias is tagged like every other node; a type node in place of the tag is not an alias.
+    EXPECT_THROW(AST::JSONReader::read(R"({"children": [{"name": "A", )"
+                                       R"("type": {"name": "int", "type": "SimpleType"}}], "type": "ASTRoot"})"),
+                 std::runtime_error);
+    EXPECT_THROW(AST::JSONReader::read("[]"), std::runtime_error);
+    EXPECT_EQ(AST::JSONReader::read(R"({"type": "ASTRoot", "children": []})")->children.size(), 0u);
+}
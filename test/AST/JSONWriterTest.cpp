@@ -0,0 +1,42 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "AST/JSONWriter.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+#include "AST/AST.h"
+#include "AST/FlatAST.h"
+#include "TestUtility.h"
+
+using namespace TinyCobalt;
+using namespace TinyCobalt::Test;
+
+namespace {
+    std::string write(const AST::ASTNodePtr &node) {
+        std::ostringstream os;
+        AST::JSONWriter(os).write(node);
+        return os.str();
+    }
+} // namespace
+
+TEST(AST, JSONWriterMatchesDump) {
+    auto root = parse(kProgram);
+    EXPECT_EQ(write(root), root->toJSON().dump());
+    for (const auto &child: root->children)
+        EXPECT_EQ(write(child), child->toJSON().dump());
+}
+
+TEST(AST, JSONWriterFlatAST) {
+    auto root = parse(kProgram);
+    AST::FlatAST flat(root);
+    EXPECT_EQ(write(flat.root()), root->toJSON().dump());
+    EXPECT_EQ(write(flat.node(flat.children()[0])), root->children[0]->toJSON().dump());
+}
+
+TEST(AST, JSONWriterEscape) {
+    AST::ASTNodePtr node = std::make_shared<AST::VariableNode>("\"q\" \\ \b\f\n\r\t \x01\x1f \x7f");
+    EXPECT_EQ(write(node), node->toJSON().dump());
+    EXPECT_EQ(write(nullptr), "null");
+}
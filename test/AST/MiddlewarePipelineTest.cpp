@@ -0,0 +1,62 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "AST/MiddlewarePipeline.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AST/ASTNodeDecl.h"
+#include "AST/ASTVisitor.h"
+#include "Common/Assert.h"
+#include "TestUtility.h"
+
+using namespace TinyCobalt;
+using namespace AST;
+using namespace TinyCobalt::Test;
+
+namespace {
+    using Pipeline = MiddlewarePipeline<Recorder<'a'>, Recorder<'b'>>;
+
+    TINY_COBALT_CONCEPT_ASSERT(ASTVisitorMiddlewareConcept, Pipeline);
+
+    // Each stage of the pipeline sees what it sees when visiting on its own.
+    void expectSameAsAlone(ExprNodePtr expr, VisitorState expected) {
+        BaseASTVisitor<Pipeline> fused;
+        BaseASTVisitor<Recorder<'a'>> alone_a;
+        BaseASTVisitor<Recorder<'b'>> alone_b;
+        EXPECT_EQ(fused.visit(expr), expected);
+        alone_a.visit(expr);
+        alone_b.visit(expr);
+        EXPECT_EQ(fused.middleware().stage<0>().log, alone_a.middleware().log);
+        EXPECT_EQ(fused.middleware().stage<Recorder<'b'>>().log, alone_b.middleware().log);
+    }
+} // namespace
+
+TEST(AST, MiddlewarePipelineStages) {
+    expectSameAsAlone(call({"skipa", "conta", "stopb", "x", "skipb", "stopa", "y"}), VisitorState::Normal);
+    expectSameAsAlone(call({"contb", "exita", "x", "y"}), VisitorState::Normal);
+    expectSameAsAlone(call({"exita", "x", "exitb", "y"}), VisitorState::Exit);
+
+    BaseASTVisitor<Pipeline> visitor;
+    auto &a = visitor.middleware().stage<0>();
+    auto &b = visitor.middleware().stage<1>();
+    EXPECT_EQ(visitor.visit(call({"skipa", "stopb", "x"})), VisitorState::Normal);
+    EXPECT_EQ(a.log, "(M [f (f f) f] [skipa (skipa skipa] [stopb (stopb stopb) stopb] [x (x x) x] M)");
+    EXPECT_EQ(b.log, "(M [f (f f) f] [skipa (skipa skipa) skipa] [stopb (stopb stopb) stopb] M)");
+
+    // Stages exit on their own, and the visit goes on until both have exited.
+    a.log.clear();
+    b.log.clear();
+    EXPECT_EQ(visitor.visit(call({"exita", "x", "exitb", "y"})), VisitorState::Exit);
+    EXPECT_EQ(a.log, "(M [f (f f) f] [exita (exita");
+    EXPECT_EQ(b.log, "(M [f (f f) f] [exita (exita exita) exita] [x (x x) x] [exitb (exitb");
+
+    // A subtree both stages skip is not visited, and nothing is left over for the next visit.
+    a.log.clear();
+    b.log.clear();
+    EXPECT_EQ(visitor.visit(call({"skip"})), VisitorState::Normal);
+    EXPECT_EQ(a.log, "(M [f (f f) f] [skip (skip skip] M)");
+    EXPECT_EQ(b.log, a.log);
+}
@@ -0,0 +1,118 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#ifndef TINY_COBALT_TEST_AST_TESTUTILITY_H_
+#define TINY_COBALT_TEST_AST_TESTUTILITY_H_
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AST/AST.h"
+#include "AST/ASTVisitor.h"
+#include "Common/Utility.h"
+#include "LexerParser/Parser.h"
+
+namespace TinyCobalt::Test {
+
+    // A program with every kind of node, for the tests that convert whole trees.
+    inline constexpr const char *kProgram = R"(
+        struct Point { int x; int y; };
+        using Table = Map<int, Array<Point, 16>>;
+        int add(int a, int b) { return a + b; }
+        int(int, char) f;
+        void main() {
+            Point p;
+            int s = 0x10;
+            float r = 2.5;
+            for (i = 0; i < 10; i++) {
+                if (i % 2 == 0) continue; else s += add(i, static_cast<int>(r));
+                while (s > 100) { s = s > 200 ? s / 2 : s - 1; break; }
+            }
+            p.x = -s;
+            print("point \\ \n", 'c', true);
+            ;
+            return;
+        }
+    )";
+
+    inline AST::ASTRootPtr parse(const std::string &input) {
+        LexerParser::Parser parser;
+        std::istringstream is(input);
+        std::ostringstream os;
+        parser.switchInput(&is).switchOutput(&os);
+        EXPECT_EQ(parser.parse(), 0);
+        return parser.result();
+    }
+
+    /**
+     * Records every call of the visitor. At a node named skip, exit, cont or stop, alone or followed by Stage, it
+     * returns the state of that name: Break from beforeSubtree(), Exit from beforeSubtree(), Continue from
+     * beforeChild() and Break from afterChild().
+     */
+    template<char Stage = '\0'>
+    struct Recorder : AST::BaseASTVisitorMiddleware<Recorder<Stage>> {
+        using VisitorState = AST::VisitorState;
+
+        std::string log;
+
+        static std::string name(const AST::ASTNodePtr &node) {
+            return pointerType<AST::VariablePtr>(node) ? proxy_cast<AST::VariablePtr>(node)->name.str() : "M";
+        }
+
+        static bool is(const std::string &text, const char *prefix) {
+            return text == prefix || (Stage != '\0' && text == prefix + std::string(1, Stage));
+        }
+
+        VisitorState record(const std::string &text, VisitorState state = VisitorState::Normal) {
+            log += log.empty() ? text : ' ' + text;
+            return state;
+        }
+
+        VisitorState beforeSubtreeImpl(AST::ASTNodePtr node) {
+            auto text = name(node);
+            if (is(text, "skip"))
+                return record('(' + text, VisitorState::Break);
+            if (is(text, "exit"))
+                return record('(' + text, VisitorState::Exit);
+            return record('(' + text);
+        }
+
+        VisitorState afterSubtreeImpl(AST::ASTNodePtr node) { return record(name(node) + ')'); }
+
+        VisitorState beforeChildImpl(AST::ASTNodePtr, AST::ASTNodePtr child) {
+            auto text = name(child);
+            return record('[' + text, is(text, "cont") ? VisitorState::Continue : VisitorState::Normal);
+        }
+
+        VisitorState afterChildImpl(AST::ASTNodePtr, AST::ASTNodePtr child) {
+            auto text = name(child);
+            return record(text + ']', is(text, "stop") ? VisitorState::Break : VisitorState::Normal);
+        }
+    };
+
+    // Counts the nodes visited.
+    struct Counter : AST::BaseASTVisitorMiddleware<Counter> {
+        std::size_t nodes = 0;
+
+        AST::VisitorState beforeSubtreeImpl(AST::ASTNodePtr) {
+            ++nodes;
+            return AST::VisitorState::Normal;
+        }
+    };
+
+    // f(names...), with a Variable node for each name.
+    inline AST::ExprNodePtr call(const std::vector<const char *> &names) {
+        std::vector<AST::ExprNodePtr> operands;
+        for (auto name: names)
+            operands.emplace_back(std::make_shared<AST::VariableNode>(name));
+        return std::make_shared<AST::MultiaryNode>(AST::MultiaryOp::FuncCall, std::make_shared<AST::VariableNode>("f"),
+                                                   operands);
+    }
+
+} // namespace TinyCobalt::Test
+
+#endif // TINY_COBALT_TEST_AST_TESTUTILITY_H_
@@ -0,0 +1,92 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AST/AST.h"
+#include "Common/Arena.h"
+#include "Common/JSON.h"
+#include "LexerParser/Parser.h"
+
+using namespace TinyCobalt;
+
+TEST(Arena, AllocateTest1) {
+    Common::Arena arena(256);
+    std::vector<std::uint64_t *> ptrs;
+    for (int i = 0; i < 100; ++i) {
+        auto *ptr = arena.allocate<std::uint64_t>();
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignof(std::uint64_t), 0);
+        *ptr = i;
+        ptrs.push_back(ptr);
+    }
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(*ptrs[i], i);
+    EXPECT_EQ(arena.allocated(), 100 * sizeof(std::uint64_t));
+}
+
+TEST(Arena, LargeAllocateTest1) {
+    Common::Arena arena(256);
+    auto *small = arena.allocate<char>(8);
+    auto *large = arena.allocate<char>(4096);
+    auto *next = arena.allocate<char>(8);
+    // The large block does not retire the current chunk.
+    EXPECT_EQ(next, small + 8);
+    EXPECT_NE(large, nullptr);
+}
+
+TEST(Arena, AllocateSharedTest1) {
+    Common::Arena arena;
+    auto str = std::allocate_shared<std::string>(Common::ArenaAllocator<std::string>(&arena), "arena");
+    EXPECT_EQ(*str, "arena");
+    EXPECT_GT(arena.allocated(), sizeof(std::string));
+}
+
+TEST(Arena, ParserTest1) {
+    AST::ASTRootPtr root;
+    {
+        LexerParser::Parser parser;
+        std::istringstream is("int f(int a) { return a + 1; } struct Point { int x; };");
+        std::ostringstream os;
+        parser.switchInput(&is).switchOutput(&os);
+        ASSERT_EQ(parser.parse(), 0);
+        root = parser.result();
+    }
+    // The root keeps the arena of its nodes alive after the parser is gone.
+    ASSERT_EQ(root->children.size(), 2);
+    EXPECT_EQ(root->toJSON()["children"][1]["name"], "Point");
+}
+
+TEST(Arena, SharedAllocateTest1) {
+    auto owner = std::make_shared<std::string>("pool");
+    std::weak_ptr<const std::string> weak_owner = owner;
+    auto arena = Common::makeArena(std::move(owner));
+    std::weak_ptr<Common::Arena> weak_arena = arena;
+    auto str = std::allocate_shared<std::string>(Common::SharedArenaAllocator<std::string>(arena), "arena");
+    arena.reset();
+    // The object keeps the arena alive, and the arena its owner.
+    EXPECT_FALSE(weak_arena.expired());
+    EXPECT_FALSE(weak_owner.expired());
+    EXPECT_EQ(*str, "arena");
+    str.reset();
+    EXPECT_TRUE(weak_arena.expired());
+    EXPECT_TRUE(weak_owner.expired());
+}
+
+TEST(Arena, ParserTest2) {
+    AST::StmtNodePtr stmt;
+    {
+        LexerParser::Parser parser;
+        std::istringstream is("int f(int a) { return a + 1; } struct Point { int x; };");
+        std::ostringstream os;
+        parser.switchInput(&is).switchOutput(&os);
+        ASSERT_EQ(parser.parse(), 0);
+        stmt = parser.result()->children[1];
+    }
+    // A node kept past its root keeps its arena and names alive.
+    EXPECT_EQ(stmt->toJSON()["name"], "Point");
+}
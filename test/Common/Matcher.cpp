@@ -3,6 +3,7 @@
 //
 
 #include <gtest/gtest.h>
+#include <cstdint>
 #include <memory>
 #include <proxy.h>
 #include <string>
@@ -152,3 +153,45 @@ TEST(Common, MatcherFunctorTest1) {
     ptr = &s;
     EXPECT_EQ(visit(Functor{}, ptr), "Elysia");
 }
+
+enum class Shape : std::uint8_t { Circle, Square, Triangle };
+
+PRO_DEF_MEM_DISPATCH(MemShapeKind, kind);
+
+struct KindAware // NOLINT
+    : pro::facade_builder // NOLINT
+      ::add_convention<MemShapeKind, Shape() const> // NOLINT
+      ::support_indirect_rtti // NOLINT
+      ::support_direct_rtti // NOLINT
+      ::build {};
+
+template<Shape K>
+struct ShapeNode {
+    static constexpr Shape kKind = K;
+    Shape kind() const { return kKind; }
+};
+
+// Shares the kind of its base, like the parameters of a function.
+struct BigSquare : ShapeNode<Shape::Square> {};
+
+TEST(Common, MatcherKindTest1) {
+    using Circle = ShapeNode<Shape::Circle>;
+    using Square = ShapeNode<Shape::Square>;
+    using Triangle = ShapeNode<Shape::Triangle>;
+    auto match = Matcher{[](std::shared_ptr<Circle>) { return 1; }, // NOLINT
+                         [](std::shared_ptr<Square>) { return 2; }, // NOLINT
+                         [](std::shared_ptr<BigSquare>) { return 3; }};
+    static_assert(detail::KindDispatch<decltype(match)::CandidateArgs, pro::proxy<KindAware>>::value);
+    pro::proxy<KindAware> ptr = std::make_shared<Circle>();
+    EXPECT_EQ(visit(match, ptr), 1);
+    ptr = std::make_shared<Square>();
+    EXPECT_EQ(visit(match, ptr), 2);
+    ptr = std::make_shared<BigSquare>();
+    EXPECT_EQ(visit(match, ptr), 3);
+    // No candidate has this kind.
+    ptr = std::make_shared<Triangle>();
+    EXPECT_EQ(visit(match, ptr), 0);
+    // The kind matches, the held type does not.
+    ptr = std::make_unique<Square>();
+    EXPECT_EQ(visit(match, ptr), 0);
+}
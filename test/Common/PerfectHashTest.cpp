@@ -0,0 +1,41 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <array>
+#include <gtest/gtest.h>
+#include <string_view>
+#include "AST/AST.h"
+#include "Common/PerfectHash.h"
+
+using namespace TinyCobalt;
+
+namespace {
+    constexpr std::array<std::string_view, 9> kKeys = {"if",     "else",  "while",       "for",       "return",
+                                                       "struct", "using", "static_cast", "const_cast"};
+    constexpr Common::PerfectHash kHash(kKeys);
+
+    static_assert(kHash.find("while") == 2);
+    static_assert(!kHash.contains("whilst"));
+} // namespace
+
+TEST(PerfectHash, FindTest1) {
+    for (std::size_t i = 0; i < kKeys.size(); ++i)
+        EXPECT_EQ(kHash.find(kKeys[i]), i);
+    EXPECT_FALSE(kHash.contains(""));
+    EXPECT_FALSE(kHash.contains("i"));
+    EXPECT_FALSE(kHash.contains("iff"));
+    EXPECT_FALSE(kHash.contains("For"));
+    EXPECT_FALSE(kHash.contains("static_cast_"));
+}
+
+TEST(PerfectHash, BuiltInTypeTest1) {
+    for (auto name: AST::BuiltInType::kNames) {
+        auto type = AST::BuiltInType::findType(name);
+        ASSERT_NE(type, nullptr);
+        EXPECT_EQ(type->name, name);
+        EXPECT_EQ(type, AST::BuiltInType::findType(name));
+    }
+    EXPECT_EQ(AST::BuiltInType::findType("integer"), nullptr);
+    EXPECT_EQ(AST::BuiltInType::findType("Int"), nullptr);
+}
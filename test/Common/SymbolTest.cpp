@@ -0,0 +1,66 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <gtest/gtest.h>
+#include <string>
+#include "Common/FlatMap.h"
+#include "Common/Symbol.h"
+
+using namespace TinyCobalt;
+using Common::StringPool;
+using Common::Symbol;
+
+TEST(Symbol, InternTest1) {
+    StringPool pool;
+    auto a = pool.intern("alpha");
+    auto b = pool.intern(std::string("alpha"));
+    auto c = pool.intern("beta");
+    EXPECT_EQ(a.data(), b.data());
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(pool.size(), 2);
+    EXPECT_EQ(a.view(), "alpha");
+    EXPECT_EQ(c.str(), "beta");
+}
+
+TEST(Symbol, CrossPoolTest1) {
+    StringPool pool1, pool2;
+    auto a = pool1.intern("name");
+    auto b = pool2.intern("name");
+    Symbol c = "name";
+    EXPECT_NE(a.data(), b.data());
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a, c);
+    EXPECT_EQ(a, "name");
+    EXPECT_EQ(a, std::string("name"));
+    EXPECT_EQ(a <=> b, std::strong_ordering::equal);
+}
+
+TEST(Symbol, EmptyTest1) {
+    StringPool pool;
+    Symbol empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty, pool.intern(""));
+    EXPECT_EQ(empty, "");
+    EXPECT_EQ(pool.size(), 0);
+}
+
+TEST(Symbol, LargeStringTest1) {
+    StringPool pool;
+    std::string large(100000, 'x');
+    auto a = pool.intern(large);
+    auto b = pool.intern("small");
+    EXPECT_EQ(a.view(), large);
+    EXPECT_EQ(b.view(), "small");
+}
+
+TEST(Symbol, FlatMapKeyTest1) {
+    StringPool pool;
+    Common::flat_map<Symbol, int> map;
+    map[pool.intern("x")] = 1;
+    map[pool.intern("y")] = 2;
+    EXPECT_EQ(map[Symbol("x")], 1);
+    EXPECT_EQ(map[Symbol("y")], 2);
+    EXPECT_EQ(map.size(), 2);
+}
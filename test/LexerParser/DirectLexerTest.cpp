@@ -0,0 +1,86 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include "AST/AST.h"
+#include "Common/JSON.h"
+#include "LexerParser/Parser.h"
+
+using namespace TinyCobalt;
+
+namespace {
+    template<typename Parser>
+    int parseWith(const std::string &input, Common::JSON &json) {
+        Parser parser;
+        std::istringstream is(input);
+        std::ostringstream os;
+        parser.switchInput(&is).switchOutput(&os);
+        auto err = parser.parse();
+        if (err == 0)
+            json = parser.result()->toJSON();
+        return err;
+    }
+
+    void expectSameTree(const std::string &input) {
+        Common::JSON flex, direct;
+        ASSERT_EQ(parseWith<LexerParser::Parser>(input, flex), 0);
+        ASSERT_EQ(parseWith<LexerParser::DirectParser>(input, direct), 0);
+        EXPECT_EQ(flex, direct);
+    }
+} // namespace
+
+TEST(LexerParser, DirectLexer1) {
+    expectSameTree(R"(
+        struct Point { int x; int y; };
+        using Callback = Function<int, int>;
+        int add(int a, int b) { return a + b; }
+        int main() {
+            Point p;
+            p.x = add(1, 2);
+            while (p.x < 10) p.x += 1;
+            for (i = 0; i <= 10; i++) { if (i % 2 == 0) continue; else break; }
+            return 0;
+        }
+    )");
+}
+
+TEST(LexerParser, DirectLexer2) {
+    expectSameTree(R"(
+        a = 0x1f + 0o17 - 0b101 * 12 / .5 % 1.25;
+        b <<= c >> 2 << 3;
+        d >>= ~e ^ f | g & h;
+        i = !j && k || l != m;
+        n = o ? 'c' : "a string";
+        p->q = r.s[t--](++u, v);
+        w = static_cast<int>(x) + const_cast<uint>(y) + reinterpret_cast<float>(z);
+        flag = true;
+    )");
+}
+
+TEST(LexerParser, DirectLexerLongRuns) {
+    std::string name(100, 'a');
+    std::string blanks(40, ' ');
+    std::string newlines(40, '\n');
+    expectSameTree(name + blanks + "=" + newlines + "1234567890123456789012345678901234567890" + blanks + ";");
+}
+
+TEST(LexerParser, DirectLexerInvalid) {
+    Common::JSON json;
+    EXPECT_NE(parseWith<LexerParser::Parser>("a = @;", json), 0);
+    EXPECT_NE(parseWith<LexerParser::DirectParser>("a = @;", json), 0);
+    EXPECT_NE(parseWith<LexerParser::DirectParser>("a = \"unterminated;", json), 0);
+}
+
+TEST(LexerParser, DirectLexerSpan) {
+    std::string input = "int f(int a) { return a * 2; }";
+    LexerParser::Parser parser;
+    std::ostringstream os;
+    parser.switchInput(std::span<const char>(input)).switchOutput(&os).switchLexer(LexerParser::LexerKind::Direct);
+    ASSERT_EQ(parser.parse(), 0);
+    Common::JSON flex;
+    ASSERT_EQ(parseWith<LexerParser::Parser>(input, flex), 0);
+    EXPECT_EQ(parser.result()->toJSON(), flex);
+}
@@ -686,3 +686,34 @@ TEST(LexerParser, CastExpr1) {
     )"_json;
     EXPECT_EQ(expected, json);
 }
+
+TEST(LexerParser, Literal1) {
+    std::string input = R"(
+        a = 0x1F + 0o017 + 1.50 + 'c' + true;
+    )";
+    INIT_TEST;
+    // The sum is left-associative, so the literals are the right operands from the last one up.
+    auto stmt = proxy_cast<AST::ExprStmtPtr>(res->children[0]);
+    auto sum = proxy_cast<AST::BinaryPtr>(proxy_cast<AST::BinaryPtr>(stmt->expr)->rhs);
+    EXPECT_EQ(std::get<bool>(proxy_cast<AST::ConstExprPtr>(sum->rhs)->value), true);
+    sum = proxy_cast<AST::BinaryPtr>(sum->lhs);
+    EXPECT_EQ(std::get<char>(proxy_cast<AST::ConstExprPtr>(sum->rhs)->value), 'c');
+    sum = proxy_cast<AST::BinaryPtr>(sum->lhs);
+    EXPECT_EQ(std::get<double>(proxy_cast<AST::ConstExprPtr>(sum->rhs)->value), 1.5);
+    sum = proxy_cast<AST::BinaryPtr>(sum->lhs);
+    EXPECT_EQ(std::get<std::uint64_t>(proxy_cast<AST::ConstExprPtr>(sum->rhs)->value), 15u);
+    EXPECT_EQ(std::get<std::uint64_t>(proxy_cast<AST::ConstExprPtr>(sum->lhs)->value), 31u);
+    // JSON shows the canonical spelling.
+    EXPECT_EQ(json["children"][0]["expr"]["rhs"]["lhs"]["lhs"]["lhs"]["lhs"]["value"], "0x1f");
+}
+
+TEST(LexerParser, Literal2) {
+    std::string input = R"(
+        a = 0x1F + 99999999999999999999;
+    )";
+    LexerParser::Parser parser;
+    std::istringstream is(input);
+    std::ostringstream os;
+    parser.switchInput(&is).switchOutput(&os);
+    EXPECT_NE(parser.parse(), 0);
+}
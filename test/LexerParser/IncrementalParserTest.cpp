@@ -0,0 +1,75 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include "AST/AST.h"
+#include "Common/JSON.h"
+#include "LexerParser/IncrementalParser.h"
+#include "LexerParser/Parser.h"
+
+using namespace TinyCobalt;
+
+namespace {
+    Common::JSON parseFull(const std::string &input) {
+        LexerParser::Parser parser;
+        std::istringstream is(input);
+        std::ostringstream os;
+        parser.switchInput(&is).switchOutput(&os);
+        EXPECT_EQ(parser.parse(), 0);
+        return parser.result()->toJSON();
+    }
+
+    const std::string kSource = "int f(int a) { return a + 1; }\n"
+                                "struct Point { int x; int y; };\n"
+                                "int g() { return f(2); }\n";
+} // namespace
+
+TEST(LexerParser, IncrementalEdit1) {
+    LexerParser::IncrementalParser parser;
+    ASSERT_EQ(parser.parse(kSource), 0);
+    auto old_root = parser.result();
+
+    // Rename y to z inside the struct.
+    auto offset = kSource.find("int y;") + 4;
+    ASSERT_EQ(parser.applyEdit({offset, 1, "z"}), 0);
+    auto root = parser.result();
+    EXPECT_EQ(root->toJSON(), parseFull(parser.source()));
+    ASSERT_EQ(root->children.size(), 3);
+    EXPECT_EQ(root->children[0], old_root->children[0]);
+    EXPECT_NE(root->children[1], old_root->children[1]);
+    EXPECT_EQ(root->children[2], old_root->children[2]);
+}
+
+TEST(LexerParser, IncrementalEdit2) {
+    LexerParser::IncrementalParser parser;
+    ASSERT_EQ(parser.parse(kSource), 0);
+
+    // Insert a statement in the gap between two statements, then edit the statement after it.
+    auto offset = kSource.find("struct");
+    ASSERT_EQ(parser.applyEdit({offset, 0, "using Alias = int;\n"}), 0);
+    EXPECT_EQ(parser.result()->toJSON(), parseFull(parser.source()));
+    EXPECT_EQ(parser.result()->children.size(), 4);
+
+    offset = parser.source().find("f(2)") + 2;
+    ASSERT_EQ(parser.applyEdit({offset, 1, "42"}), 0);
+    EXPECT_EQ(parser.result()->toJSON(), parseFull(parser.source()));
+}
+
+TEST(LexerParser, IncrementalEdit3) {
+    LexerParser::IncrementalParser parser;
+    ASSERT_EQ(parser.parse("if (a) b;\nc;\n"), 0);
+
+    // The new else only parses together with the preceding statement.
+    ASSERT_EQ(parser.applyEdit({10, 0, "else "}), 0);
+    EXPECT_EQ(parser.result()->toJSON(), parseFull(parser.source()));
+    EXPECT_EQ(parser.result()->children.size(), 1);
+
+    // Break the file, then fix it again.
+    EXPECT_NE(parser.applyEdit({0, 2, "("}), 0);
+    EXPECT_EQ(parser.result(), nullptr);
+    ASSERT_EQ(parser.applyEdit({0, 1, "if"}), 0);
+    EXPECT_EQ(parser.result()->toJSON(), parseFull(parser.source()));
+}
@@ -0,0 +1,40 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "AST/AST.h"
+#include "Common/JSON.h"
+#include "LexerParser/ParallelParse.h"
+
+using namespace TinyCobalt;
+
+TEST(LexerParser, ParallelParse1) {
+    auto dir = std::filesystem::temp_directory_path() / "tiny-cobalt-parallel-parse-test";
+    std::filesystem::create_directories(dir);
+    std::vector<std::string> files;
+    for (int i = 0; i < 32; ++i) {
+        auto path = dir / ("file" + std::to_string(i) + ".tc");
+        std::ofstream ofs(path);
+        ofs << "int f" << i << "() { return " << i << "; }";
+        files.push_back(path.string());
+    }
+    files.push_back((dir / "missing.tc").string());
+
+    auto results = LexerParser::parseFiles(files, 4);
+    ASSERT_EQ(results.size(), files.size());
+    for (int i = 0; i < 32; ++i) {
+        EXPECT_EQ(results[i].file, files[i]);
+        ASSERT_EQ(results[i].error, 0);
+        auto json = results[i].root->toJSON();
+        EXPECT_EQ(json["children"][0]["name"], "f" + std::to_string(i));
+    }
+    EXPECT_EQ(results.back().error, -1);
+    EXPECT_EQ(results.back().root, nullptr);
+    EXPECT_FALSE(results.back().message.empty());
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,86 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string>
+#include "AST/AST.h"
+#include "Common/JSON.h"
+#include "LexerParser/Parser.h"
+#include "LexerParser/SourceBuffer.h"
+
+using namespace TinyCobalt;
+
+namespace {
+    const std::string kSource = R"(
+        struct Point { int x; int y; };
+        int add(int a, int b) { return a + b; }
+        int main() {
+            Point p;
+            p.x = add(1, 2);
+            while (p.x < 10) p.x += 1;
+            return 0;
+        }
+    )";
+
+    Common::JSON parseStream(const std::string &input) {
+        LexerParser::Parser parser;
+        std::istringstream is(input);
+        std::ostringstream os;
+        parser.switchInput(&is).switchOutput(&os);
+        EXPECT_EQ(parser.parse(), 0);
+        return parser.result()->toJSON();
+    }
+} // namespace
+
+TEST(LexerParser, SourceBufferSpan) {
+    LexerParser::Parser parser;
+    std::ostringstream os;
+    parser.switchInput(std::span<const char>(kSource)).switchOutput(&os);
+    ASSERT_EQ(parser.parse(), 0);
+    EXPECT_EQ(parser.result()->toJSON(), parseStream(kSource));
+}
+
+TEST(LexerParser, SourceBufferSpanReparse) {
+    LexerParser::Parser parser;
+    std::ostringstream os;
+    auto text = std::make_unique<std::string>("int x;\nint f() {\n    return x + 1;\n}\n");
+    parser.switchInput(std::span<const char>(*text)).switchOutput(&os);
+    ASSERT_EQ(parser.parse(), 0);
+    // The same span can be parsed again.
+    ASSERT_EQ(parser.parse(), 0);
+    auto root = parser.result();
+    ASSERT_EQ(root->children.size(), 2);
+    // The SourceManager does not borrow the span, so locations are decoded after it is gone.
+    std::fill(text->begin(), text->end(), '\n');
+    text.reset();
+    auto func = proxy_cast<AST::FuncDefPtr>(root->children[1]);
+    EXPECT_EQ(parser.sources()->format(func->location), "<input>:2.1-4.1");
+}
+
+TEST(LexerParser, SourceBufferMappedFile) {
+    auto path = std::filesystem::temp_directory_path() / "tiny-cobalt-source-buffer-test.tc";
+    {
+        std::ofstream ofs(path, std::ios::binary);
+        ofs << kSource;
+    }
+    auto buffer = LexerParser::SourceBuffer::map(path.string());
+    EXPECT_EQ(std::string(buffer.begin(), buffer.end()), kSource);
+
+    LexerParser::Parser parser;
+    std::ostringstream os;
+    parser.switchInputFile(path.string()).switchOutput(&os);
+    ASSERT_EQ(parser.parse(), 0);
+    EXPECT_EQ(parser.result()->toJSON(), parseStream(kSource));
+    std::filesystem::remove(path);
+}
+
+TEST(LexerParser, SourceBufferMissingFile) {
+    EXPECT_THROW(LexerParser::SourceBuffer::map("/nonexistent/tiny-cobalt.tc"), std::system_error);
+}
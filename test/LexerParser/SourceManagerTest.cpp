@@ -0,0 +1,94 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AST/AST.h"
+#include "LexerParser/Parser.h"
+#include "LexerParser/SourceManager.h"
+
+using namespace TinyCobalt;
+using LexerParser::Location;
+using LexerParser::SourceBuffer;
+using LexerParser::SourceManager;
+
+TEST(SourceManager, DecodeTest1) {
+    SourceManager sources;
+    std::string a = "ab\ncd\n";
+    std::string b = "x\ny";
+    const auto &file_a = sources.addFile("a.tc", SourceBuffer(std::span<const char>(a)));
+    const auto &file_b = sources.addFile("b.tc", SourceBuffer(std::vector<char>(b.begin(), b.end())));
+    EXPECT_EQ(file_a.base, 0);
+    EXPECT_GT(file_b.base, file_a.end());
+
+    auto decoded = sources.decode(4);
+    EXPECT_EQ(decoded.file, "a.tc");
+    EXPECT_EQ(decoded.line, 2);
+    EXPECT_EQ(decoded.column, 2);
+
+    decoded = sources.decode(file_b.base + 2);
+    EXPECT_EQ(decoded.file, "b.tc");
+    EXPECT_EQ(decoded.line, 2);
+    EXPECT_EQ(decoded.column, 1);
+
+    EXPECT_EQ(sources.format(Location(0, 5)), "a.tc:1.1-2.2");
+    EXPECT_EQ(sources.format(Location(3, 5)), "a.tc:2.1-2");
+    EXPECT_EQ(sources.findFile(file_b.end() + 1), nullptr);
+}
+
+TEST(SourceManager, NodeLocationTest1) {
+    std::string input = "int x;\nint f() {\n    return x + 1;\n}\n";
+    LexerParser::Parser parser;
+    std::istringstream is(input);
+    std::ostringstream os;
+    parser.switchInput(&is).switchOutput(&os);
+    ASSERT_EQ(parser.parse(), 0);
+    auto root = parser.result();
+    auto sources = parser.sources();
+    ASSERT_EQ(root->children.size(), 2);
+
+    auto def = proxy_cast<AST::VariableDefPtr>(root->children[0]);
+    EXPECT_EQ(sources->format(def->location), "<input>:1.1-6");
+
+    auto func = proxy_cast<AST::FuncDefPtr>(root->children[1]);
+    EXPECT_EQ(sources->format(func->location), "<input>:2.1-4.1");
+    auto body = proxy_cast<AST::BlockPtr>(func->body);
+    auto ret = proxy_cast<AST::ReturnPtr>(body->stmts[0]);
+    EXPECT_EQ(sources->format(ret->location), "<input>:3.5-17");
+    auto value = proxy_cast<AST::BinaryPtr>(ret->value);
+    EXPECT_EQ(sources->format(value->location), "<input>:3.12-16");
+}
+
+TEST(SourceManager, ReuseParserTest1) {
+    LexerParser::Parser parser;
+    std::istringstream first("int x;\n");
+    parser.switchInput(&first);
+    ASSERT_EQ(parser.parse(), 0);
+    auto first_sources = parser.sources();
+    auto def = proxy_cast<AST::VariableDefPtr>(parser.result()->children[0]);
+
+    // The input of the first parse is not kept by the second one.
+    std::istringstream second("\nint y;\n");
+    parser.switchInput(&second);
+    ASSERT_EQ(parser.parse(), 0);
+    EXPECT_NE(parser.sources(), first_sources);
+    EXPECT_EQ(parser.sources()->findFile(0)->text().size(), 8u);
+    EXPECT_EQ(first_sources->format(def->location), "<input>:1.1-6");
+
+    // A manager set by the caller collects every input.
+    auto shared = std::make_shared<SourceManager>();
+    parser.setSourceManager(shared);
+    std::istringstream third("int z;\n");
+    parser.switchInput(&third);
+    ASSERT_EQ(parser.parse(), 0);
+    std::istringstream fourth("int w;\n");
+    parser.switchInput(&fourth);
+    ASSERT_EQ(parser.parse(), 0);
+    EXPECT_EQ(parser.sources(), shared);
+    EXPECT_NE(shared->findFile(8), nullptr);
+}
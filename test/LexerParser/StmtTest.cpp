@@ -598,7 +598,7 @@ TEST(LexerParser, AliasDefStmt1) {
             {
                 "type": "AliasDef",
                 "name": "A",
-                "type": {
+                "type_node": {
                     "type": "SimpleType",
                     "name": "int"
                 }
@@ -626,3 +626,86 @@ TEST(LexerParser, EmptyStmt1) {
     )"_json;
     EXPECT_EQ(expected, json);
 }
+
+TEST(LexerParser, TopLevelSink1) {
+    std::string input = R"(
+        struct Point { int x; };
+        using Alias = Point;
+        int main() { if (a) { b; } return 0; }
+        int global = 1;
+    )";
+    std::vector<Common::JSON> streamed;
+    LexerParser::Parser parser;
+    std::istringstream is(input);
+    std::ostringstream os;
+    parser.switchInput(&is).switchOutput(&os).setTopLevelSink(
+            [&](AST::StmtNodePtr stmt) { streamed.push_back(stmt->toJSON()); });
+    ASSERT_EQ(parser.parse(), 0);
+    EXPECT_TRUE(parser.result()->children.empty());
+
+    LexerParser::Parser reference;
+    std::istringstream ref_is(input);
+    reference.switchInput(&ref_is).switchOutput(&os);
+    ASSERT_EQ(reference.parse(), 0);
+    auto expected = reference.result()->toJSON()["children"];
+    ASSERT_EQ(streamed.size(), expected.size());
+    for (std::size_t i = 0; i < streamed.size(); ++i)
+        EXPECT_EQ(streamed[i], expected[i]);
+}
+
+TEST(LexerParser, TopLevelSink2) {
+    std::vector<AST::StmtNodePtr> streamed;
+    {
+        LexerParser::Parser parser;
+        std::istringstream is("struct Point { int x; };\nint global = 1;");
+        std::ostringstream os;
+        parser.switchInput(&is).switchOutput(&os).setTopLevelSink(
+                [&](AST::StmtNodePtr stmt) { streamed.push_back(std::move(stmt)); });
+        ASSERT_EQ(parser.parse(), 0);
+    }
+    // The statements keep their names alive after the parser and its root are gone.
+    ASSERT_EQ(streamed.size(), 2);
+    auto point = proxy_cast<AST::StructDefPtr>(streamed[0]);
+    EXPECT_EQ(point->name, "Point");
+    EXPECT_EQ(point->fields[0]->name, "x");
+    EXPECT_EQ(streamed[1]->toJSON()["name"], "global");
+}
+
+TEST(LexerParser, ErrorRecovery1) {
+    std::string input = R"(a = 1 +;
+b = 2;
+c = @;
+if (d) { e = ; }
+f = 3;
+)";
+    LexerParser::Parser parser;
+    std::istringstream is(input);
+    parser.switchInput(&is);
+    EXPECT_NE(parser.parse(), 0);
+
+    // Every error is reported, not only the first one.
+    const auto &diagnostics = parser.diagnostics();
+    ASSERT_EQ(diagnostics.size(), 3);
+    auto sources = parser.sources();
+    EXPECT_EQ(sources->format(diagnostics[0].location), "<input>:1.8");
+    EXPECT_EQ(sources->format(diagnostics[1].location), "<input>:3.5");
+    EXPECT_NE(diagnostics[1].message.find("invalid character"), std::string::npos);
+    EXPECT_EQ(sources->format(diagnostics[2].location), "<input>:4.14");
+
+    // The statements around the errors are kept.
+    auto res = parser.result();
+    ASSERT_NE(res, nullptr);
+    ASSERT_EQ(res->children.size(), 5);
+    Common::JSON json = res->toJSON();
+    EXPECT_EQ(json["children"][0]["type"], "EmptyStmt");
+    EXPECT_EQ(json["children"][1]["type"], "ExprStmt");
+    EXPECT_EQ(json["children"][2]["type"], "EmptyStmt");
+    EXPECT_EQ(json["children"][3]["type"], "If");
+    EXPECT_EQ(json["children"][4]["type"], "ExprStmt");
+
+    // A clean parse clears the diagnostics.
+    std::istringstream is2("g = 4;");
+    parser.switchInput(&is2);
+    EXPECT_EQ(parser.parse(), 0);
+    EXPECT_TRUE(parser.diagnostics().empty());
+}
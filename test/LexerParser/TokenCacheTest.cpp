@@ -0,0 +1,95 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include "AST/AST.h"
+#include "Common/JSON.h"
+#include "LexerParser/Parser.h"
+
+using namespace TinyCobalt;
+
+namespace {
+    int parseCached(const std::string &dir, const std::string &input, Common::JSON &json) {
+        LexerParser::Parser parser;
+        std::istringstream is(input);
+        parser.switchInput(&is).setTokenCacheDir(dir);
+        auto err = parser.parse();
+        if (err == 0)
+            json = parser.result()->toJSON();
+        return err;
+    }
+
+    std::size_t countFiles(const std::filesystem::path &dir) {
+        std::size_t count = 0;
+        for ([[maybe_unused]] const auto &entry: std::filesystem::directory_iterator(dir))
+            ++count;
+        return count;
+    }
+} // namespace
+
+TEST(LexerParser, TokenCache1) {
+    auto dir = std::filesystem::temp_directory_path() / "tiny-cobalt-token-cache-test";
+    std::filesystem::remove_all(dir);
+    std::string input = R"(
+        struct Point { int x; int y; };
+        int main() {
+            Point p;
+            p.x = 0x1f + 0b11 + 2;
+            s = "str" + 'c';
+            return p.x * 1.5 < 3 && true;
+        }
+    )";
+
+    LexerParser::Parser parser;
+    std::istringstream is(input);
+    parser.switchInput(&is);
+    ASSERT_EQ(parser.parse(), 0);
+    Common::JSON expected = parser.result()->toJSON();
+
+    // The first parse stores the tokens, the second one replays them.
+    Common::JSON json;
+    ASSERT_EQ(parseCached(dir.string(), input, json), 0);
+    EXPECT_EQ(json, expected);
+    ASSERT_EQ(countFiles(dir), 1);
+    ASSERT_EQ(parseCached(dir.string(), input, json), 0);
+    EXPECT_EQ(json, expected);
+    EXPECT_EQ(countFiles(dir), 1);
+
+    // A damaged file is ignored and replaced.
+    auto file = std::filesystem::directory_iterator(dir)->path();
+    auto size = std::filesystem::file_size(file);
+    std::filesystem::resize_file(file, size / 2);
+    ASSERT_EQ(parseCached(dir.string(), input, json), 0);
+    EXPECT_EQ(json, expected);
+    EXPECT_EQ(std::filesystem::file_size(file), size);
+
+    // A file for another text with the same name, here faked by changing the half of the hash not in the name, is not
+    // replayed but replaced.
+    std::string stored;
+    {
+        std::ifstream ifs(file, std::ios::binary);
+        stored.assign(std::istreambuf_iterator<char>(ifs), {});
+    }
+    {
+        std::fstream fs(file, std::ios::binary | std::ios::in | std::ios::out);
+        fs.seekp(32);
+        fs.put(static_cast<char>(stored[32] ^ 1));
+    }
+    ASSERT_EQ(parseCached(dir.string(), input, json), 0);
+    EXPECT_EQ(json, expected);
+    std::ifstream ifs(file, std::ios::binary);
+    EXPECT_EQ(std::string(std::istreambuf_iterator<char>(ifs), {}), stored);
+
+    // A failed parse does not store anything.
+    Common::JSON unused;
+    EXPECT_NE(parseCached(dir.string(), "a = ;", unused), 0);
+    EXPECT_EQ(countFiles(dir), 1);
+
+    std::filesystem::remove_all(dir);
+}
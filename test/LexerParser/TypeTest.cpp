@@ -350,4 +350,66 @@ TEST(LexerParser, ComplexType6) {
     }
     )"_json;
     EXPECT_EQ(expected, json);
-}
\ No newline at end of file
+}
+TEST(LexerParser, ComplexType7) {
+    std::string input = R"(Pointer<Array<int, 3>> x;)";
+    INIT_TEST
+    Common::JSON expected = R"(
+    {
+        "type": "ASTRoot",
+        "children": [
+            {
+                "type": "VariableDef",
+                "type_node": {
+                    "type": "ComplexType",
+                    "template_name": "Pointer",
+                    "template_args": [
+                        {
+                            "type": "ComplexType",
+                            "template_name": "Array",
+                            "template_args": [
+                                {
+                                    "type": "SimpleType",
+                                    "name": "int"
+                                },
+                                {
+                                    "type": "ConstExpr",
+                                    "value": "3",
+                                    "expr_type": "Int"
+                                }
+                            ]
+                        }
+                    ]
+                },
+                "name": "x",
+                "init": null
+            }
+        ]
+    }
+    )"_json;
+    EXPECT_EQ(expected, json);
+}
+
+TEST(LexerParser, ComplexType8) {
+    // ">>>" and ">>>>" close several lists, and ">>" outside of templates is still a shift.
+    std::string input = R"(
+        Pointer<Pointer<Pointer<int>>> a = b >> 1;
+        Map<int, Pointer<Pointer<Pointer<int>>>> c;
+        d = static_cast<Pointer<Pointer<int>>>(e) >> 2;
+    )";
+    INIT_TEST
+    auto depth = [](Common::JSON type) {
+        int res = 0;
+        while (type["type"] == "ComplexType") {
+            type = type["template_args"].back();
+            ++res;
+        }
+        return res;
+    };
+    ASSERT_EQ(json["children"].size(), 3);
+    EXPECT_EQ(depth(json["children"][0]["type_node"]), 3);
+    EXPECT_EQ(json["children"][0]["init"]["op"], "BitRShift");
+    EXPECT_EQ(depth(json["children"][1]["type_node"]), 4);
+    EXPECT_EQ(json["children"][2]["expr"]["rhs"]["op"], "BitRShift");
+    EXPECT_EQ(depth(json["children"][2]["expr"]["rhs"]["lhs"]["cast_type"]), 2);
+}
@@ -70,8 +70,8 @@ TEST(Semantic, DeclMatcherTest2) {
                             a = Node<VariablePtr> { "a"s }(),
                             BinaryOp::Assign,
                             Node<ConstExprPtr> {
-                                "1"s,
-                                ConstExprType::Int
+                                ConstExprType::Int,
+                                "1"s
                             }(),
                         }(),
                     }(),
@@ -87,8 +87,8 @@ TEST(Semantic, DeclMatcherTest2) {
                                         b = Node<VariablePtr> { "b"s }(),
                                         BinaryOp::Assign,
                                         Node<ConstExprPtr> {
-                                            "2"s,
-                                            ConstExprType::Int
+                                            ConstExprType::Int,
+                                            "2"s
                                         }()
                                     }(),
                                 }()
@@ -100,8 +100,8 @@ TEST(Semantic, DeclMatcherTest2) {
                             c = Node<VariablePtr> { "c"s }(),
                             BinaryOp::Assign,
                             Node<ConstExprPtr> {
-                                "3"s,
-                                ConstExprType::Int
+                                ConstExprType::Int,
+                                "3"s
                             }(),
                         }(),
                     }(),
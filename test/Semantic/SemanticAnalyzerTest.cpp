@@ -3,4 +3,47 @@
 //
 
 #include <gtest/gtest.h>
+#include "AST/ASTBuilder.h"
+#include "AST/ASTNodeDecl.h"
+#include "AST/ASTRootNode.h"
+#include "AST/ExprNode.h"
+#include "AST/StmtNode.h"
+#include "AST/TypeNode.h"
 #include "Semantic/SemanticAnalyzer.h"
+
+using namespace TinyCobalt;
+
+using std::string_literals::operator""s;
+
+using namespace AST;
+using namespace AST::Builder;
+
+TEST(Semantic, SemanticAnalyzerTest1) {
+    VariableDefPtr aptr, bptr;
+    VariablePtr a, b;
+    BinaryPtr sum;
+    // clang-format off
+    auto ast = Node<ASTRootPtr> {
+        Array<StmtNodePtr> {
+            aptr = Node<VariableDefPtr> { Node<SimpleTypePtr>{ "int"s }(), "a"s }(),
+            bptr = Node<VariableDefPtr> { Node<SimpleTypePtr>{ "int"s }(), "b"s }(),
+            Node<ExprStmtPtr> {
+                sum = Node<BinaryPtr> {
+                    a = Node<VariablePtr> { "a"s }(),
+                    BinaryOp::Add,
+                    b = Node<VariablePtr> { "b"s }()
+                }()
+            }()
+        }()
+    }();
+    // clang-format on
+    Semantic::SemanticAnalyzer visitor;
+    EXPECT_EQ(visitor.visit(ast), VisitorState::Normal);
+    // Both passes have run in the same walk.
+    EXPECT_EQ(a->def, aptr);
+    EXPECT_EQ(b->def, bptr);
+    ASSERT_TRUE(a->exprType());
+    ASSERT_TRUE(sum->exprType());
+    EXPECT_EQ(a->exprType()->toJSON()["name"], "int");
+    EXPECT_EQ(sum->exprType()->toJSON()["name"], "int");
+}
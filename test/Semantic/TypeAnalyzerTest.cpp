@@ -0,0 +1,34 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "AST/ASTNodeDecl.h"
+#include "AST/ASTVisitor.h"
+#include "AST/ExprNode.h"
+#include "Semantic/TypeAnalyzer.h"
+
+using namespace TinyCobalt;
+using namespace AST;
+
+using TypeAnalyzerVisitor = AST::BaseASTVisitor<Semantic::TypeAnalyzer>;
+
+TEST(Semantic, TypeAnalyzerPerNodeType) {
+    auto one = std::make_shared<ConstExprNode>(ConstExprType::Int, "1");
+    auto sum = std::make_shared<BinaryNode>(one, BinaryOp::Add, one);
+    auto less = std::make_shared<BinaryNode>(sum, BinaryOp::Less, one);
+    TypeAnalyzerVisitor visitor;
+    EXPECT_EQ(visitor.visit(less), VisitorState::Normal);
+
+    ASSERT_TRUE(one->exprType());
+    ASSERT_TRUE(sum->exprType());
+    ASSERT_TRUE(less->exprType());
+    EXPECT_EQ(one->exprType()->toJSON()["name"], "int");
+    EXPECT_EQ(sum->exprType()->toJSON()["name"], "int");
+    // Nodes of the same kind keep their own results.
+    EXPECT_EQ(less->exprType()->toJSON()["name"], "bool");
+
+    auto other = std::make_shared<BinaryNode>(one, BinaryOp::Mul, one);
+    EXPECT_FALSE(other->exprType());
+}
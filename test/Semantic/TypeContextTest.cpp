@@ -0,0 +1,82 @@
+//
+// Created by agent on 10/17/2026
+//
+
+#include "Semantic/TypeContext.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <variant>
+#include <vector>
+#include "AST/ASTNodeDecl.h"
+#include "AST/TypeNode.h"
+
+using namespace TinyCobalt;
+using namespace AST;
+
+TEST(Semantic, TypeContextSimple) {
+    Semantic::TypeContext types;
+    auto size = types.size();
+    EXPECT_EQ(types.simple("int"), BuiltInType::findType("int"));
+    EXPECT_EQ(types.simple("Point"), types.simple("Point"));
+    EXPECT_NE(types.simple("Point"), types.simple("Line"));
+    EXPECT_EQ(types.size(), size + 2);
+}
+
+TEST(Semantic, TypeContextStructural) {
+    Semantic::TypeContext types;
+    // Two separately allocated trees of Map<int, Pointer<char>>.
+    auto make = [] {
+        using Args = std::vector<ComplexTypeNode::TemplateArgType>;
+        TypeNodePtr pointer = std::make_shared<ComplexTypeNode>(
+                "Pointer", Args{TypeNodePtr(std::make_shared<SimpleTypeNode>("char"))});
+        return TypeNodePtr(std::make_shared<ComplexTypeNode>(
+                "Map", Args{TypeNodePtr(std::make_shared<SimpleTypeNode>("int")), pointer}));
+    };
+    auto lhs = make(), rhs = make();
+    EXPECT_FALSE(lhs->convertibleTo(rhs));
+    auto canonical = types.intern(lhs);
+    EXPECT_TRUE(Semantic::TypeContext::same(canonical, types.intern(rhs)));
+    EXPECT_TRUE(canonical->convertibleTo(types.intern(rhs)));
+    EXPECT_EQ(canonical->toJSON(), lhs->toJSON());
+
+    auto char_pointer = types.pointer(types.simple("char"));
+    EXPECT_EQ(char_pointer, types.pointer(BuiltInType::findType("char")));
+    EXPECT_TRUE(Semantic::TypeContext::same(types.pointee(char_pointer), types.simple("char")));
+    EXPECT_FALSE(types.pointee(types.simple("char")));
+    EXPECT_FALSE(Semantic::TypeContext::same(char_pointer, types.pointer(types.simple("int"))));
+
+    auto array = [&](const char *size) {
+        return types.complex("Array", {TypeNodePtr(types.simple("int")),
+                                       std::make_shared<ConstExprNode>(ConstExprType::Int, size)});
+    };
+    EXPECT_EQ(array("3"), array("3"));
+    EXPECT_NE(array("3"), array("4"));
+
+    auto func = types.func(types.simple("void"), {types.simple("int"), char_pointer});
+    EXPECT_EQ(func, types.func(BuiltInType::findType("void"), {BuiltInType::findType("int"), char_pointer}));
+    EXPECT_NE(func, types.func(types.simple("void"), {char_pointer, types.simple("int")}));
+}
+
+TEST(Semantic, TypeContextDeclared) {
+    Semantic::TypeContext types;
+    // Two declarations of struct A, e.g. in nested scopes.
+    auto outer = std::make_shared<StructDefNode>("A");
+    auto inner = std::make_shared<StructDefNode>("A");
+    auto outer_type = types.simple("A", outer);
+    EXPECT_EQ(types.simple("A", outer), outer_type);
+    EXPECT_NE(types.simple("A", inner), outer_type);
+    EXPECT_NE(types.simple("A"), outer_type);
+    ASSERT_TRUE(std::holds_alternative<StructDefPtr>(outer_type->def));
+    EXPECT_EQ(std::get<StructDefPtr>(outer_type->def), outer);
+
+    // Types written in the tree are canonicalized through their resolved declaration.
+    auto written = std::make_shared<SimpleTypeNode>("A");
+    written->def = inner;
+    EXPECT_TRUE(Semantic::TypeContext::same(types.intern(written), types.simple("A", inner)));
+    EXPECT_EQ(types.simple("int", BuiltInType::findType("int")), BuiltInType::findType("int"));
+
+    auto array = types.complex("Array", {TypeNodePtr(outer_type)});
+    EXPECT_TRUE(Semantic::TypeContext::same(types.element(array), outer_type));
+    EXPECT_TRUE(Semantic::TypeContext::same(types.element(types.pointer(outer_type)), outer_type));
+    EXPECT_FALSE(types.pointee(array));
+}
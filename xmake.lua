@@ -8,3 +8,4 @@ set_languages("c89", "cxxlatest")
 
 includes("src")
 includes("test")
+includes("bench")